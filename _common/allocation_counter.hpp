@@ -0,0 +1,69 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// test helper - replaces the global operator new/delete (plain and nothrow) to count heap allocations
+// (array forms call these by default)
+// replacement functions cannot be inline - include this header in exactly one translation unit of a test program
+
+namespace AllocationCounter
+{
+    inline std::atomic<size_t> counter{0}; // threads allocate too
+}
+
+void* operator new(size_t size)
+{
+    ++AllocationCounter::counter;
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    ++AllocationCounter::counter;
+
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+// memory comes from std::malloc above - GCC 11+ sees only the operator new call at the call site
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+// number of heap allocations made while f() runs
+template <typename F>
+size_t count_allocations(F f)
+{
+    const size_t before = AllocationCounter::counter;
+    f();
+    return AllocationCounter::counter - before;
+}
+
+#endif // ALLOCATION_COUNTER_HPP
@@ -5,7 +5,14 @@
 #include <string_view>
 #include <vector>
 #include <algorithm>
-
+#include <array>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include "catch.hpp"
 
 using namespace std;
@@ -31,6 +38,62 @@ TEST_CASE("matches - returns how many items is stored in a container")
     REQUIRE(matches("abccdef", 'a', 'c', 'f') == 4);
 }
 
+// single pass over the container - every element is compared with all items at once
+// (for arithmetic types the fold of comparisons is turned by the compiler into SIMD broadcast compares)
+template <typename TContainer, typename... TArgs>
+size_t matches_single_pass(const TContainer& vec, const TArgs&... items)
+{
+    size_t counter = 0;
+
+    for (const auto& value : vec)
+        counter += (... + static_cast<size_t>(value == items));
+
+    return counter;
+}
+
+TEST_CASE("matches_single_pass - returns the same results as matches")
+{
+    vector<int> v{1, 2, 3, 4, 5};
+
+    REQUIRE(matches_single_pass(v, 2, 5) == 2);
+    REQUIRE(matches_single_pass(v, 100, 200) == 0);
+    REQUIRE(matches_single_pass(v, 2, 2) == matches(v, 2, 2));
+    REQUIRE(matches_single_pass("abccdef", 'x', 'y', 'z') == 0);
+    REQUIRE(matches_single_pass("abccdef", 'a', 'c', 'f') == 4);
+
+    vector<string> words{"one", "two", "one", "three"};
+    REQUIRE(matches_single_pass(words, "one"s, "three"s) == matches(words, "one"s, "three"s));
+}
+
+template <typename TContainer, size_t... Is>
+void benchmark_matches(const TContainer& data, std::index_sequence<Is...>)
+{
+    using T = typename TContainer::value_type;
+
+    BENCHMARK("matches - " + to_string(sizeof...(Is)) + " items")
+    {
+        return matches(data, static_cast<T>(Is * 7)...);
+    };
+
+    BENCHMARK("matches_single_pass - " + to_string(sizeof...(Is)) + " items")
+    {
+        return matches_single_pass(data, static_cast<T>(Is * 7)...);
+    };
+}
+
+TEST_CASE("matches - benchmark", "[.][benchmark]")
+{
+    vector<int> data(10'000'000);
+    std::iota(begin(data), end(data), 0);
+    std::transform(begin(data), end(data), begin(data), [](int x) { return x % 128; });
+
+    benchmark_matches(data, std::make_index_sequence<1>{});
+    benchmark_matches(data, std::make_index_sequence<2>{});
+    benchmark_matches(data, std::make_index_sequence<4>{});
+    benchmark_matches(data, std::make_index_sequence<8>{});
+    benchmark_matches(data, std::make_index_sequence<16>{});
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 class Gadget
@@ -98,6 +161,63 @@ TEST_CASE("make_vector - create vector from a list of arguments")
     }
 }
 
+// inline storage - capacity == sizeof...(Ts), no heap allocation
+template <typename... Ts>
+constexpr std::array<std::common_type_t<Ts...>, sizeof...(Ts)> make_static_vector(Ts&&... args)
+{
+    using T = std::common_type_t<Ts...>;
+
+    return { static_cast<T>(std::forward<Ts>(args))... };
+}
+
+TEST_CASE("make_static_vector - create fixed capacity container from a list of arguments")
+{
+    using namespace Catch::Matchers;
+
+    SECTION("ints")
+    {
+        int x = 10;
+
+        auto v = make_static_vector(1, 2, 3, x);
+
+        static_assert(is_same_v<decltype(v), std::array<int, 4>>);
+        REQUIRE(v == std::array{1, 2, 3, 10});
+    }
+
+    SECTION("common type")
+    {
+        constexpr auto v = make_static_vector(1, 2.5, 3.0f);
+
+        static_assert(is_same_v<decltype(v)::value_type, double>);
+        static_assert(v[1] == 2.5);
+    }
+
+    SECTION("unique_ptrs with polymorphic hierarchy")
+    {
+        auto gadgets = make_static_vector(make_unique<Gadget>(), make_unique<SuperGadget>(), make_unique<Gadget>());
+
+        static_assert(is_same_v<decltype(gadgets)::value_type, unique_ptr<Gadget>>);
+
+        vector<string> ids;
+        transform(begin(gadgets), end(gadgets), back_inserter(ids), [](auto& ptr) { return ptr->id(); });
+
+        REQUIRE_THAT(ids, Equals(vector<string>{"a", "b", "a"}));
+    }
+}
+
+TEST_CASE("make_vector - benchmark", "[.][benchmark]")
+{
+    BENCHMARK("make_vector")
+    {
+        return make_vector(1, 2, 3, 4, 5, 6, 7, 8);
+    };
+
+    BENCHMARK("make_static_vector")
+    {
+        return make_static_vector(1, 2, 3, 4, 5, 6, 7, 8);
+    };
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename T>
@@ -122,4 +242,112 @@ TEST_CASE("all_within - checks if all values fit in range [low, high]")
     REQUIRE(all_within(Range{10, 20.0}, 1, 15, 30) == false);
     REQUIRE(all_within(Range{10, 20}, 11, 12, 13) == true);
     REQUIRE(all_within(Range{5.0, 5.5}, 5.1, 5.2, 5.3) == true);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// batch versions for contiguous ranges
+
+template <typename TContainer>
+using EnableIfContiguous = std::void_t<decltype(std::data(std::declval<const TContainer&>())),
+                                       decltype(std::size(std::declval<const TContainer&>()))>;
+
+template <typename T, typename TContainer, typename = EnableIfContiguous<TContainer>>
+bool all_within(const Range<T>& range, const TContainer& values)
+{
+    constexpr size_t block_size = 256;
+
+    const auto* first = std::data(values);
+    const size_t size = std::size(values);
+
+    for (size_t block_start = 0; block_start < size; block_start += block_size)
+    {
+        const size_t block_end = std::min(size, block_start + block_size);
+
+        // branchless inside the block - the loop is vectorized by the compiler
+        // (NaN fails both comparisons so it is reported as out of range)
+        unsigned out_of_range = 0;
+        for (size_t i = block_start; i < block_end; ++i)
+            out_of_range |= !((first[i] >= range.low) & (first[i] <= range.high));
+
+        if (out_of_range) // early exit once per block
+            return false;
+    }
+
+    return true;
+}
+
+template <typename T, typename TContainer, typename = EnableIfContiguous<TContainer>>
+size_t count_within(const Range<T>& range, const TContainer& values)
+{
+    const auto* first = std::data(values);
+    const size_t size = std::size(values);
+
+    size_t counter = 0;
+    for (size_t i = 0; i < size; ++i)
+        counter += (first[i] >= range.low) & (first[i] <= range.high);
+
+    return counter;
+}
+
+// values in range are moved to the front - returns the end of this partition
+template <typename T, typename TContainer, typename = EnableIfContiguous<TContainer>>
+auto partition_within(const Range<T>& range, TContainer& values)
+{
+    return std::partition(std::begin(values), std::end(values),
+        [&range](const auto& value) { return value >= range.low && value <= range.high; });
+}
+
+TEST_CASE("all_within - contiguous ranges")
+{
+    vector<int> data(1000);
+    std::iota(begin(data), end(data), 0);
+
+    REQUIRE(all_within(Range{0, 999}, data) == true);
+    REQUIRE(all_within(Range{0, 998.5}, data) == false);
+    REQUIRE(all_within(Range{10, 20}, vector<int>{}) == true);
+
+    std::array<double, 3> arr = {5.1, 5.2, 5.3};
+    REQUIRE(all_within(Range{5.0, 5.5}, arr) == true);
+
+    double native[] = {1.0, std::numeric_limits<double>::quiet_NaN()};
+    REQUIRE(all_within(Range{0.0, 2.0}, native) == false);
+
+    SECTION("variadic version is still selected for scalars")
+    {
+        REQUIRE(all_within(Range{10, 20}, 15) == true);
+    }
+
+    SECTION("count_within")
+    {
+        REQUIRE(count_within(Range{100, 199.5}, data) == 100);
+    }
+
+    SECTION("partition_within")
+    {
+        vector<int> values = {1, 15, 30, 12, -5, 20};
+
+        auto pos = partition_within(Range{10, 20}, values);
+
+        REQUIRE(std::distance(begin(values), pos) == 3);
+        REQUIRE(std::all_of(begin(values), pos, [](int x) { return x >= 10 && x <= 20; }));
+        REQUIRE(std::none_of(pos, end(values), [](int x) { return x >= 10 && x <= 20; }));
+    }
+}
+
+TEST_CASE("all_within - benchmark", "[.][benchmark]")
+{
+    vector<int> data(10'000'000);
+    std::iota(begin(data), end(data), 0);
+
+    const Range range{0, 10'000'000};
+
+    BENCHMARK("loop with all_within(range, item)")
+    {
+        return std::all_of(begin(data), end(data), [&range](int x) { return all_within(range, x); });
+    };
+
+    BENCHMARK("all_within(range, contiguous_range)")
+    {
+        return all_within(range, data);
+    };
 }
\ No newline at end of file
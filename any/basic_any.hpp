@@ -0,0 +1,277 @@
+#ifndef BASIC_ANY_HPP
+#define BASIC_ANY_HPP
+
+#include <any>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "type_id.hpp"
+
+// std::any with a user-chosen small buffer - types that fit into InlineSize bytes
+// (with alignment <= Align) and are nothrow movable are stored without heap allocation
+template <size_t InlineSize = 3 * sizeof(void*), size_t Align = alignof(std::max_align_t)>
+class BasicAny
+{
+    static_assert(InlineSize >= sizeof(void*), "inline buffer must be able to hold a pointer");
+
+    union Storage
+    {
+        alignas(Align) unsigned char buffer[InlineSize];
+        void* heap;
+    };
+
+    // one static table per stored type - its address identifies the type (no RTTI)
+    struct Operations
+    {
+        void (*destroy)(Storage& storage) noexcept;
+        void (*copy)(const Storage& source, Storage& target);
+        void (*move)(Storage& source, Storage& target) noexcept;
+        bool is_inline;
+        TypeId type;
+    };
+
+    template <typename T>
+    static constexpr bool fits_inline_v = sizeof(T) <= InlineSize && alignof(T) <= Align && Align % alignof(T) == 0
+                                          && std::is_nothrow_move_constructible_v<T>;
+
+    template <typename T>
+    struct InlineOperations
+    {
+        static T* get(Storage& storage) noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(storage.buffer));
+        }
+
+        static const T* get(const Storage& storage) noexcept
+        {
+            return std::launder(reinterpret_cast<const T*>(storage.buffer));
+        }
+
+        static void destroy(Storage& storage) noexcept
+        {
+            std::destroy_at(get(storage));
+        }
+
+        static void copy(const Storage& source, Storage& target)
+        {
+            ::new (static_cast<void*>(target.buffer)) T(*get(source));
+        }
+
+        static void move(Storage& source, Storage& target) noexcept
+        {
+            ::new (static_cast<void*>(target.buffer)) T(std::move(*get(source)));
+            destroy(source);
+        }
+
+        static constexpr Operations table{&destroy, &copy, &move, true, type_id<T>()};
+    };
+
+    template <typename T>
+    struct HeapOperations
+    {
+        static T* get(Storage& storage) noexcept
+        {
+            return static_cast<T*>(storage.heap);
+        }
+
+        static const T* get(const Storage& storage) noexcept
+        {
+            return static_cast<const T*>(storage.heap);
+        }
+
+        static void destroy(Storage& storage) noexcept
+        {
+            delete get(storage);
+        }
+
+        static void copy(const Storage& source, Storage& target)
+        {
+            target.heap = new T(*get(source));
+        }
+
+        static void move(Storage& source, Storage& target) noexcept
+        {
+            target.heap = source.heap;
+        }
+
+        static constexpr Operations table{&destroy, &copy, &move, false, type_id<T>()};
+    };
+
+    template <typename T>
+    using OperationsFor = std::conditional_t<fits_inline_v<T>, InlineOperations<T>, HeapOperations<T>>;
+
+    Storage storage_;
+    const Operations* operations_ = nullptr;
+
+public:
+    static constexpr size_t inline_size = InlineSize;
+
+    template <typename T>
+    static constexpr bool is_stored_inline_v = fits_inline_v<std::decay_t<T>>;
+
+    BasicAny() noexcept = default;
+
+    template <typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, BasicAny>>>
+    BasicAny(T&& value)
+    {
+        emplace<std::decay_t<T>>(std::forward<T>(value));
+    }
+
+    BasicAny(const BasicAny& source)
+    {
+        if (source.operations_)
+        {
+            source.operations_->copy(source.storage_, storage_);
+            operations_ = source.operations_;
+        }
+    }
+
+    BasicAny(BasicAny&& source) noexcept
+    {
+        if (source.operations_)
+        {
+            source.operations_->move(source.storage_, storage_);
+            operations_ = std::exchange(source.operations_, nullptr);
+        }
+    }
+
+    BasicAny& operator=(const BasicAny& source)
+    {
+        BasicAny(source).swap(*this);
+        return *this;
+    }
+
+    BasicAny& operator=(BasicAny&& source) noexcept
+    {
+        if (this != &source)
+        {
+            reset();
+
+            if (source.operations_)
+            {
+                source.operations_->move(source.storage_, storage_);
+                operations_ = std::exchange(source.operations_, nullptr);
+            }
+        }
+
+        return *this;
+    }
+
+    template <typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, BasicAny>>>
+    BasicAny& operator=(T&& value)
+    {
+        BasicAny(std::forward<T>(value)).swap(*this);
+        return *this;
+    }
+
+    ~BasicAny()
+    {
+        reset();
+    }
+
+    template <typename T, typename... TArgs>
+    T& emplace(TArgs&&... args)
+    {
+        reset();
+
+        T* item;
+        if constexpr (fits_inline_v<T>)
+            item = ::new (static_cast<void*>(storage_.buffer)) T(std::forward<TArgs>(args)...);
+        else
+            storage_.heap = item = new T(std::forward<TArgs>(args)...);
+
+        operations_ = &OperationsFor<T>::table;
+
+        return *item;
+    }
+
+    void reset() noexcept
+    {
+        if (operations_)
+        {
+            operations_->destroy(storage_);
+            operations_ = nullptr;
+        }
+    }
+
+    void swap(BasicAny& other) noexcept
+    {
+        BasicAny temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    bool has_value() const noexcept
+    {
+        return operations_ != nullptr;
+    }
+
+    bool is_inline() const noexcept
+    {
+        return operations_ && operations_->is_inline;
+    }
+
+    // counterpart of std::any::type() - type_id<void>() when empty
+    TypeId type() const noexcept
+    {
+        return operations_ ? operations_->type : type_id<void>();
+    }
+
+    // type check is a single pointer comparison
+    template <typename T>
+    bool holds() const noexcept
+    {
+        return operations_ == &OperationsFor<T>::table;
+    }
+
+    template <typename T>
+    T* get_if() noexcept
+    {
+        return holds<T>() ? OperationsFor<T>::get(storage_) : nullptr;
+    }
+
+    template <typename T>
+    const T* get_if() const noexcept
+    {
+        return holds<T>() ? OperationsFor<T>::get(storage_) : nullptr;
+    }
+};
+
+template <typename T, size_t InlineSize, size_t Align>
+T* any_cast(BasicAny<InlineSize, Align>* any) noexcept
+{
+    return any ? any->template get_if<std::remove_cv_t<T>>() : nullptr;
+}
+
+template <typename T, size_t InlineSize, size_t Align>
+const T* any_cast(const BasicAny<InlineSize, Align>* any) noexcept
+{
+    return any ? any->template get_if<std::remove_cv_t<T>>() : nullptr;
+}
+
+template <typename T, size_t InlineSize, size_t Align>
+T any_cast(const BasicAny<InlineSize, Align>& any)
+{
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+
+    if (const U* item = any.template get_if<U>())
+        return static_cast<T>(*item);
+
+    throw std::bad_any_cast{};
+}
+
+template <typename T, size_t InlineSize, size_t Align>
+T any_cast(BasicAny<InlineSize, Align>& any)
+{
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+
+    if (U* item = any.template get_if<U>())
+        return static_cast<T>(*item);
+
+    throw std::bad_any_cast{};
+}
+
+#endif // BASIC_ANY_HPP
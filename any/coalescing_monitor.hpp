@@ -0,0 +1,163 @@
+#ifndef COALESCING_MONITOR_HPP
+#define COALESCING_MONITOR_HPP
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "event_bus.hpp"
+
+struct SensorReading
+{
+    uint32_t sensor_id;
+    double value;
+};
+
+// one notification per interval with the latest changed readings of all sensors
+template <typename TTimePoint>
+struct ReadingsFrame
+{
+    TTimePoint time;
+    const SensorReading* readings;
+    size_t count;
+
+    const SensorReading* begin() const noexcept
+    {
+        return readings;
+    }
+
+    const SensorReading* end() const noexcept
+    {
+        return readings + count;
+    }
+};
+
+// collects readings of many sensors and notifies observers with periodic frames:
+// - coalescing - only the latest reading of a sensor within an interval is kept
+// - deadband - a reading is delivered only if it differs from the last delivered value by more than deadband
+//   (deadband 0 suppresses only unchanged readings)
+// record() is O(1) and never allocates; all buffers are sized for sensor_count up front
+// (not thread-safe - feed it from a single thread or through ObserverRegistry/AsyncSubscriber)
+template <typename TClock = std::chrono::steady_clock>
+class CoalescingMonitor
+{
+public:
+    using Clock = TClock;
+    using Frame = ReadingsFrame<typename Clock::time_point>;
+
+private:
+    static constexpr double never_delivered = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<double> latest_;
+    std::vector<double> delivered_;
+    std::vector<bool> dirty_;
+    std::vector<uint32_t> dirty_sensors_;
+    std::vector<SensorReading> frame_;
+
+    double deadband_;
+    typename Clock::duration interval_;
+    typename Clock::time_point next_frame_;
+
+    EventBus<Frame> observers_;
+
+    size_t received_count_ = 0;
+    size_t delivered_count_ = 0;
+
+    bool exceeds_deadband(uint32_t sensor) const noexcept
+    {
+        return std::isnan(delivered_[sensor]) || std::abs(latest_[sensor] - delivered_[sensor]) > deadband_;
+    }
+
+public:
+    CoalescingMonitor(size_t sensor_count, double deadband, typename Clock::duration interval,
+        typename Clock::time_point start = Clock::now())
+        : latest_(sensor_count)
+        , delivered_(sensor_count, never_delivered)
+        , dirty_(sensor_count)
+        , deadband_{deadband}
+        , interval_{interval}
+        , next_frame_{start + interval}
+    {
+        dirty_sensors_.reserve(sensor_count);
+        frame_.reserve(sensor_count);
+    }
+
+    EventBus<Frame>& observers() noexcept
+    {
+        return observers_;
+    }
+
+    void record(uint32_t sensor, double value) noexcept
+    {
+        ++received_count_;
+
+        latest_[sensor] = value;
+
+        if (!dirty_[sensor])
+        {
+            dirty_[sensor] = true;
+            dirty_sensors_.push_back(sensor);
+        }
+    }
+
+    // publishes a frame when the interval has elapsed; returns true if the frame was due
+    bool tick(typename Clock::time_point now)
+    {
+        if (now < next_frame_)
+            return false;
+
+        flush(now);
+
+        next_frame_ += interval_;
+        if (next_frame_ <= now) // skip intervals missed by a late tick
+            next_frame_ = now + interval_;
+
+        return true;
+    }
+
+    // publishes pending readings immediately (observers are not called for an empty frame)
+    void flush(typename Clock::time_point now = Clock::now())
+    {
+        frame_.clear();
+
+        for (const uint32_t sensor : dirty_sensors_)
+        {
+            dirty_[sensor] = false;
+
+            if (exceeds_deadband(sensor))
+            {
+                delivered_[sensor] = latest_[sensor];
+                frame_.push_back(SensorReading{sensor, latest_[sensor]});
+            }
+        }
+
+        dirty_sensors_.clear();
+
+        if (frame_.empty())
+            return;
+
+        delivered_count_ += frame_.size();
+        observers_.publish(Frame{now, frame_.data(), frame_.size()});
+    }
+
+    size_t received_count() const noexcept
+    {
+        return received_count_;
+    }
+
+    size_t delivered_count() const noexcept
+    {
+        return delivered_count_;
+    }
+
+    // last value delivered to observers (NaN if none yet)
+    double delivered_value(uint32_t sensor) const noexcept
+    {
+        return delivered_[sensor];
+    }
+};
+
+#endif // COALESCING_MONITOR_HPP
@@ -0,0 +1,428 @@
+#ifndef CONCURRENT_OBSERVERS_HPP
+#define CONCURRENT_OBSERVERS_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "event_bus.hpp"
+
+// subscriber list for publishing from many threads - RCU style:
+// - publish() reads an immutable snapshot of the list; it never locks or allocates
+// - subscribe()/unsubscribe() copy the list, swap the pointer and retire the old snapshot;
+//   writers are serialized and unsubscribe() waits until publishers in flight are done,
+//   so the handler may be destroyed as soon as it returns
+// readers are counted per epoch (two counters): unsubscribe() flips the epoch and waits only for readers
+// that started before - a stream of new publishers cannot starve it
+// a handler may unsubscribe (itself or others) during publish() - that call cannot wait for readers
+// (it is one of them), so the handler may still be called by other threads publishing at the same time
+template <typename TEvent>
+class ObserverRegistry
+{
+    struct Entry
+    {
+        SubscriptionId id;
+        EventHandler<TEvent> handler;
+    };
+
+    using Snapshot = std::vector<Entry>;
+
+    std::atomic<const Snapshot*> current_;
+    std::atomic<size_t> epoch_{0};
+    mutable std::atomic<size_t> readers_[2] = {};
+
+    std::mutex writer_mutex_;
+    std::mutex grace_period_mutex_; // held while waiting for readers - writer_mutex_ is not, so handlers may write
+    std::vector<std::unique_ptr<const Snapshot>> retired_;
+    SubscriptionId next_id_ = 0;
+
+    // read sections of the current thread (innermost first) - to detect calls from handlers
+    struct ReadScope
+    {
+        const ObserverRegistry* registry;
+        const ReadScope* outer;
+    };
+
+    inline static thread_local const ReadScope* read_scopes_ = nullptr;
+
+    // every operation on epoch_, readers_ and current_ is seq_cst: a reader counted in a counter
+    // the writer has seen drained after the swap can only load the new snapshot
+    class ReadGuard
+    {
+        std::atomic<size_t>& readers_;
+        ReadScope scope_;
+
+    public:
+        explicit ReadGuard(const ObserverRegistry& registry) noexcept
+            : readers_{registry.readers_[registry.epoch_.load() % 2]}, scope_{&registry, read_scopes_}
+        {
+            readers_.fetch_add(1);
+            read_scopes_ = &scope_;
+        }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        ~ReadGuard()
+        {
+            read_scopes_ = scope_.outer;
+            readers_.fetch_sub(1);
+        }
+    };
+
+    bool is_reading() const noexcept
+    {
+        for (const ReadScope* scope = read_scopes_; scope != nullptr; scope = scope->outer)
+            if (scope->registry == this)
+                return true;
+        return false;
+    }
+
+    void replace(std::unique_ptr<Snapshot> snapshot)
+    {
+        retired_.emplace_back(current_.exchange(snapshot.release()));
+    }
+
+    // grace period - two flips, so readers that loaded the epoch just before the first flip
+    // (and were counted late in the old counter) are waited for as well
+    void wait_for_readers()
+    {
+        std::lock_guard lk{grace_period_mutex_};
+
+        for (int flip = 0; flip < 2; ++flip)
+        {
+            const size_t previous = epoch_.fetch_add(1);
+            while (readers_[previous % 2].load() != 0)
+                std::this_thread::yield();
+        }
+    }
+
+    // no reader at all - nobody can hold a retired snapshot
+    void free_retired_if_idle()
+    {
+        if (readers_[0].load() == 0 && readers_[1].load() == 0)
+            retired_.clear();
+    }
+
+public:
+    ObserverRegistry()
+        : current_{new Snapshot{}}
+    {
+    }
+
+    ObserverRegistry(const ObserverRegistry&) = delete;
+    ObserverRegistry& operator=(const ObserverRegistry&) = delete;
+
+    ~ObserverRegistry()
+    {
+        delete current_.load();
+    }
+
+    SubscriptionId subscribe(EventHandler<TEvent> handler)
+    {
+        std::lock_guard lk{writer_mutex_};
+
+        auto snapshot = std::make_unique<Snapshot>(*current_.load());
+        snapshot->push_back(Entry{next_id_, handler});
+        replace(std::move(snapshot));
+
+        free_retired_if_idle();
+
+        return next_id_++;
+    }
+
+    template <auto Method, typename T>
+    SubscriptionId subscribe(T& object)
+    {
+        return subscribe(EventHandler<TEvent>::template bind<Method>(object));
+    }
+
+    bool unsubscribe(SubscriptionId id)
+    {
+        std::vector<std::unique_ptr<const Snapshot>> retired;
+
+        {
+            std::lock_guard lk{writer_mutex_};
+
+            const Snapshot& current = *current_.load();
+
+            auto snapshot = std::make_unique<Snapshot>();
+            snapshot->reserve(current.size());
+            for (const auto& entry : current)
+                if (entry.id != id)
+                    snapshot->push_back(entry);
+
+            if (snapshot->size() == current.size())
+                return false;
+
+            replace(std::move(snapshot));
+
+            if (is_reading())
+                return true; // called from a handler - retired snapshots are freed by a later writer
+
+            retired.swap(retired_);
+        }
+
+        wait_for_readers(); // all snapshots retired so far were replaced before it started
+
+        return true;
+    }
+
+    size_t subscriber_count() const
+    {
+        ReadGuard guard{*this};
+
+        return current_.load()->size();
+    }
+
+    // safe to call concurrently from any number of threads
+    void publish(const TEvent& event)
+    {
+        ReadGuard guard{*this};
+
+        for (const auto& entry : *current_.load())
+            entry.handler(event);
+    }
+};
+
+// bounded multi-producer/single-consumer ring buffer - each cell carries a sequence number
+// telling whether it is free for the producer with a given ticket or ready for the consumer
+// (T must be default constructible)
+template <typename T>
+class BoundedQueue
+{
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    static constexpr size_t cache_line_size = 64;
+
+    std::unique_ptr<Cell[]> cells_;
+    const size_t mask_;
+
+    alignas(cache_line_size) std::atomic<size_t> enqueue_position_{0};
+    alignas(cache_line_size) size_t dequeue_position_ = 0; // owned by the consumer
+
+    static size_t round_up_to_pow2(size_t value)
+    {
+        size_t result = 2;
+        while (result < value)
+            result *= 2;
+        return result;
+    }
+
+public:
+    explicit BoundedQueue(size_t capacity)
+        : cells_{new Cell[round_up_to_pow2(capacity)]}, mask_{round_up_to_pow2(capacity) - 1}
+    {
+        for (size_t i = 0; i <= mask_; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const noexcept
+    {
+        return mask_ + 1;
+    }
+
+    // never blocks - returns false when the queue is full
+    bool try_push(const T& value)
+    {
+        size_t position = enqueue_position_.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (difference == 0)
+            {
+                if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+                return false;
+            else
+                position = enqueue_position_.load(std::memory_order_relaxed);
+        }
+    }
+
+    // single consumer only
+    bool try_pop(T& value)
+    {
+        Cell& cell = cells_[dequeue_position_ & mask_];
+
+        if (cell.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1)
+            return false;
+
+        value = std::move(cell.value);
+        cell.sequence.store(dequeue_position_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_position_;
+
+        return true;
+    }
+};
+
+// delivers events to a (possibly slow) handler on its own thread -
+// publishers only enqueue, so their latency does not depend on the handler;
+// when the queue is full the event is dropped and counted
+// an idle worker spins briefly and then sleeps on a condition variable - a publisher takes the mutex
+// only to wake it up (otherwise enqueue() costs a fence and a load)
+// (unsubscribe handler() before the subscriber is destroyed)
+template <typename TEvent>
+class AsyncSubscriber
+{
+    static constexpr int spin_count = 64;
+
+    EventHandler<TEvent> handler_;
+    BoundedQueue<TEvent> queue_;
+    std::atomic<size_t> dropped_{0};
+    std::atomic<bool> stopped_{false};
+
+    std::atomic<bool> sleeping_{false};
+    std::atomic<size_t> sleep_count_{0};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+
+    std::thread worker_;
+
+    bool try_pop_spinning(TEvent& event)
+    {
+        for (int i = 0; i < spin_count; ++i)
+        {
+            if (queue_.try_pop(event))
+                return true;
+            std::this_thread::yield();
+        }
+
+        return false;
+    }
+
+    // the worker announces sleeping_ and re-checks the queue, a publisher pushes and checks sleeping_ -
+    // with a full fence on both sides at least one of them sees the other (no lost wake-up)
+    bool wait_for_event(TEvent& event)
+    {
+        std::unique_lock lk{wake_mutex_};
+
+        sleeping_.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (queue_.try_pop(event))
+        {
+            sleeping_.store(false);
+            return true;
+        }
+
+        if (stopped_.load())
+        {
+            sleeping_.store(false);
+            return false;
+        }
+
+        sleep_count_.fetch_add(1, std::memory_order_relaxed);
+        wake_.wait(lk, [this] { return !sleeping_.load(); });
+
+        return false;
+    }
+
+    void wake_up()
+    {
+        {
+            std::lock_guard lk{wake_mutex_};
+            sleeping_.store(false);
+        }
+        wake_.notify_one();
+    }
+
+    void run()
+    {
+        TEvent event;
+
+        for (;;)
+        {
+            if (try_pop_spinning(event) || wait_for_event(event))
+                handler_(event);
+            else if (stopped_.load(std::memory_order_acquire))
+            {
+                while (queue_.try_pop(event)) // drain events pushed before stop
+                    handler_(event);
+                return;
+            }
+        }
+    }
+
+public:
+    explicit AsyncSubscriber(EventHandler<TEvent> handler, size_t queue_capacity = 1024)
+        : handler_{handler}, queue_{queue_capacity}, worker_{[this] { run(); }}
+    {
+    }
+
+    AsyncSubscriber(const AsyncSubscriber&) = delete;
+    AsyncSubscriber& operator=(const AsyncSubscriber&) = delete;
+
+    ~AsyncSubscriber()
+    {
+        stop();
+    }
+
+    // delivers all queued events and joins the worker
+    void stop()
+    {
+        stopped_.store(true, std::memory_order_release);
+        wake_up();
+
+        if (worker_.joinable())
+            worker_.join();
+    }
+
+    void enqueue(const TEvent& event)
+    {
+        if (!queue_.try_push(event))
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (sleeping_.load(std::memory_order_relaxed))
+            wake_up();
+    }
+
+    size_t dropped_count() const noexcept
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    // the worker is blocked waiting for events
+    bool is_sleeping() const noexcept
+    {
+        return sleeping_.load();
+    }
+
+    // how many times the worker has blocked waiting for events
+    size_t sleep_count() const noexcept
+    {
+        return sleep_count_.load(std::memory_order_relaxed);
+    }
+
+    // handler to be registered in ObserverRegistry/EventBus
+    EventHandler<TEvent> handler() noexcept
+    {
+        return EventHandler<TEvent>::template bind<&AsyncSubscriber::enqueue>(*this);
+    }
+};
+
+#endif // CONCURRENT_OBSERVERS_HPP
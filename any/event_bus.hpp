@@ -0,0 +1,185 @@
+#ifndef EVENT_BUS_HPP
+#define EVENT_BUS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// non-owning callback for a single event type - an object pointer and a function pointer
+// (no std::function, no allocation; the bound object must outlive the subscription)
+template <typename TEvent>
+class EventHandler
+{
+    void* object_;
+    void (*invoke_)(void* object, const TEvent& event);
+
+    EventHandler(void* object, void (*invoke)(void*, const TEvent&)) noexcept
+        : object_{object}, invoke_{invoke}
+    {
+    }
+
+public:
+    template <auto Method, typename T>
+    static EventHandler bind(T& object) noexcept
+    {
+        return EventHandler{std::addressof(object), [](void* target, const TEvent& event) {
+                                (static_cast<T*>(target)->*Method)(event);
+                            }};
+    }
+
+    template <typename F>
+    static EventHandler bind(F& callable) noexcept
+    {
+        return EventHandler{std::addressof(callable), [](void* target, const TEvent& event) {
+                                (*static_cast<F*>(target))(event);
+                            }};
+    }
+
+    void operator()(const TEvent& event) const
+    {
+        invoke_(object_, event);
+    }
+};
+
+using SubscriptionId = uint64_t;
+
+// statically typed publish/subscribe - every event type has its own channel resolved at compile time,
+// events are passed by const reference (no type erasure of the payload, no formatting)
+// - publish() delivers immediately
+// - post() queues an event; dispatch() delivers queued events subscriber by subscriber
+// handlers may post events (delivered by the next dispatch()), but must not subscribe/unsubscribe or call dispatch()
+template <typename... TEvents>
+class EventBus
+{
+    template <typename TEvent>
+    struct Channel
+    {
+        std::vector<EventHandler<TEvent>> handlers;
+        std::vector<SubscriptionId> ids;
+        std::vector<TEvent> pending;
+        std::vector<TEvent> delivering; // pending events swapped out for dispatch - kept for its capacity
+    };
+
+    std::tuple<Channel<TEvents>...> channels_;
+    SubscriptionId next_id_ = 0;
+
+    template <typename TEvent>
+    Channel<TEvent>& channel()
+    {
+        static_assert((... || std::is_same_v<TEvent, TEvents>), "event type is not handled by this bus");
+
+        return std::get<Channel<TEvent>>(channels_);
+    }
+
+    template <typename TEvent>
+    const Channel<TEvent>& channel() const
+    {
+        return std::get<Channel<TEvent>>(channels_);
+    }
+
+    template <typename TEvent>
+    bool unsubscribe_from(SubscriptionId id)
+    {
+        auto& ch = channel<TEvent>();
+
+        auto pos = std::find(ch.ids.begin(), ch.ids.end(), id);
+        if (pos == ch.ids.end())
+            return false;
+
+        const auto index = pos - ch.ids.begin();
+        ch.ids.erase(pos);
+        ch.handlers.erase(ch.handlers.begin() + index);
+
+        return true;
+    }
+
+    template <typename TEvent>
+    void dispatch_channel()
+    {
+        auto& ch = channel<TEvent>();
+
+        if (ch.pending.empty())
+            return;
+
+        // events posted by handlers during delivery go to the (empty) pending queue - they wait for the next dispatch()
+        std::swap(ch.pending, ch.delivering);
+        publish(ch.delivering.data(), ch.delivering.size());
+        ch.delivering.clear(); // capacity is kept for the next batch
+    }
+
+public:
+    template <typename TEvent>
+    SubscriptionId subscribe(EventHandler<TEvent> handler)
+    {
+        auto& ch = channel<TEvent>();
+
+        ch.handlers.push_back(handler);
+        ch.ids.push_back(next_id_);
+
+        return next_id_++;
+    }
+
+    // bus.subscribe<TemperatureChanged, &Logger::on_temperature>(logger)
+    template <typename TEvent, auto Method, typename T>
+    SubscriptionId subscribe(T& object)
+    {
+        return subscribe(EventHandler<TEvent>::template bind<Method>(object));
+    }
+
+    // callable is stored by reference
+    template <typename TEvent, typename F>
+    SubscriptionId subscribe(F& callable)
+    {
+        return subscribe(EventHandler<TEvent>::bind(callable));
+    }
+
+    bool unsubscribe(SubscriptionId id)
+    {
+        return (... || unsubscribe_from<TEvents>(id));
+    }
+
+    template <typename TEvent>
+    size_t subscriber_count() const
+    {
+        return channel<TEvent>().handlers.size();
+    }
+
+    template <typename TEvent>
+    void publish(const TEvent& event)
+    {
+        for (const auto& handler : channel<TEvent>().handlers)
+            handler(event);
+    }
+
+    // batch delivery - each handler gets all events in turn while its state is hot in cache
+    template <typename TEvent>
+    void publish(const TEvent* events, size_t count)
+    {
+        for (const auto& handler : channel<TEvent>().handlers)
+            for (size_t i = 0; i < count; ++i)
+                handler(events[i]);
+    }
+
+    template <typename TEvent>
+    void post(TEvent event)
+    {
+        channel<TEvent>().pending.push_back(std::move(event));
+    }
+
+    template <typename TEvent>
+    size_t pending_count() const
+    {
+        return channel<TEvent>().pending.size();
+    }
+
+    void dispatch()
+    {
+        (..., dispatch_channel<TEvents>());
+    }
+};
+
+#endif // EVENT_BUS_HPP
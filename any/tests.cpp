@@ -1,11 +1,22 @@
 #include <algorithm>
 #include <any>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <numeric>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include "catch.hpp"
+#include "../_common/allocation_counter.hpp"
+#include "basic_any.hpp"
+#include "coalescing_monitor.hpp"
+#include "concurrent_observers.hpp"
+#include "event_bus.hpp"
 
 using namespace std;
 
@@ -44,6 +55,147 @@ TEST_CASE("any")
     }
 }
 
+TEST_CASE("BasicAny")
+{
+    using Any = BasicAny<64>;
+
+    Any a;
+
+    REQUIRE(a.has_value() == false);
+
+    a = 4;
+    a = 3.14;
+    a = "text"s;
+    a = vector {1, 2, 3};
+
+    REQUIRE(a.has_value());
+    REQUIRE(a.is_inline());
+
+    SECTION("any_cast by copy")
+    {
+        auto vec = any_cast<std::vector<int>>(a);
+        REQUIRE(vec == vector {1, 2, 3});
+
+        REQUIRE_THROWS_AS(any_cast<std::string>(a), std::bad_any_cast);
+    }
+
+    SECTION("any_cast by pointer")
+    {
+        if (auto* vec_ptr = any_cast<std::vector<int>>(&a); vec_ptr)
+        {
+            vec_ptr->push_back(4);
+            REQUIRE(a.holds<vector<int>>());
+            REQUIRE(a.type() == type_id<vector<int>>());
+        }
+
+        REQUIRE(any_cast<std::string>(&a) == nullptr);
+        REQUIRE(any_cast<const std::vector<int>&>(a).size() == 4);
+    }
+
+    SECTION("copy & move")
+    {
+        static_assert(std::is_nothrow_move_constructible_v<Any>);
+        static_assert(std::is_nothrow_move_assignable_v<Any>);
+
+        Any copy = a;
+        REQUIRE(any_cast<vector<int>>(copy) == vector {1, 2, 3});
+
+        Any target = std::move(a);
+        REQUIRE(any_cast<vector<int>>(target) == vector {1, 2, 3});
+        REQUIRE_FALSE(a.has_value());
+    }
+
+    SECTION("large types are stored on heap")
+    {
+        using Large = std::array<char, 100>;
+
+        a = Large{'a'};
+        REQUIRE_FALSE(a.is_inline());
+        REQUIRE(any_cast<Large>(a)[0] == 'a');
+
+        Any target = std::move(a);
+        REQUIRE(any_cast<Large&>(target)[0] == 'a');
+    }
+}
+
+TEST_CASE("TypeId - RTTI-free type identity")
+{
+    static_assert(type_id<int>() == type_id<int>());
+    static_assert(type_id<int>() != type_id<double>());
+    static_assert(type_id<const int&>() == type_id<int>());
+
+    REQUIRE(type_id<int>().name() == "int");
+    REQUIRE(type_id<std::vector<int>>().name().find("vector") != std::string_view::npos);
+
+    REQUIRE(BasicAny<>{}.type() == type_id<void>());
+    REQUIRE(BasicAny<>{3.14}.type() == type_id<double>());
+
+    std::unordered_map<TypeId, std::string> descriptions = {
+        {type_id<int>(), "integer"},
+        {type_id<std::string>(), "text"}
+    };
+
+    REQUIRE(descriptions.at(BasicAny<>{"abc"s}.type()) == "text");
+}
+
+TEST_CASE("TypeId - benchmark", "[.][benchmark]")
+{
+    std::any std_any = vector {1, 2, 3};
+    BasicAny<> basic_any = vector {1, 2, 3};
+
+    BENCHMARK("std::any - type() == typeid")
+    {
+        return std_any.type() == typeid(std::string);
+    };
+
+    BENCHMARK("BasicAny - type() == type_id")
+    {
+        return basic_any.type() == type_id<std::string>();
+    };
+}
+
+struct Payload48
+{
+    std::array<double, 6> values;
+};
+
+TEST_CASE("BasicAny - allocations vs. std::any")
+{
+    auto std_any_allocations = count_allocations([] {
+        std::any a = "text that does not fit into SSO buffer"s;
+        a = vector {1, 2, 3};
+        a = Payload48{};
+        std::any b = a;
+    });
+
+    size_t basic_any_allocations = count_allocations([] {
+        BasicAny<64> a = "text that does not fit into SSO buffer"s; // 1 allocation - string's buffer
+        a = vector {1, 2, 3}; // 1 allocation - vector's buffer
+        a = Payload48{};
+        BasicAny<64> b = a;
+    });
+
+    REQUIRE(basic_any_allocations == 2);
+    REQUIRE(std_any_allocations > basic_any_allocations);
+}
+
+TEST_CASE("BasicAny - benchmark", "[.][benchmark]")
+{
+    BENCHMARK("std::any - Payload48")
+    {
+        std::any a = Payload48{{1.0}};
+        std::any b = a;
+        return std::any_cast<Payload48>(&b)->values[0];
+    };
+
+    BENCHMARK("BasicAny<64> - Payload48")
+    {
+        BasicAny<64> a = Payload48{{1.0}};
+        BasicAny<64> b = a;
+        return any_cast<Payload48>(&b)->values[0];
+    };
+}
+
 ////////////////////////////////////
 // wide interfaces
 
@@ -58,6 +210,11 @@ class TempMonitor
 {
     std::vector<Observer*> observes_;
 public:
+    void attach(Observer* o)
+    {
+        observes_.push_back(o);
+    }
+
     void notify()
     {
         for(const auto& o : observes_)
@@ -78,4 +235,674 @@ public:
         if (monitor)
             (*monitor)->get_temp();
     }
-};
\ No newline at end of file
+};
+
+////////////////////////////////////
+// typed events - no std::any, no formatting on the publisher side
+
+namespace TypedEvents
+{
+    class TempMonitor;
+
+    struct TemperatureChanged
+    {
+        const TempMonitor* sender;
+        double temperature;
+    };
+
+    struct SensorFailure
+    {
+        const TempMonitor* sender;
+        int error_code;
+    };
+
+    using SensorBus = EventBus<TemperatureChanged, SensorFailure>;
+
+    class TempMonitor
+    {
+        SensorBus& bus_;
+        double temp_;
+
+    public:
+        TempMonitor(SensorBus& bus, double temp = 23.88)
+            : bus_{bus}, temp_{temp}
+        {
+        }
+
+        void notify()
+        {
+            bus_.publish(TemperatureChanged{this, get_temp()});
+        }
+
+        void set_temp(double temp)
+        {
+            temp_ = temp;
+            bus_.post(TemperatureChanged{this, temp_});
+        }
+
+        double get_temp() const
+        {
+            return temp_;
+        }
+    };
+
+    class Logger
+    {
+    public:
+        std::vector<std::string> log;
+
+        // text is created only by the subscriber that needs it
+        void on_temperature(const TemperatureChanged& event)
+        {
+            log.push_back(std::to_string(event.temperature));
+        }
+    };
+
+    struct Statistics
+    {
+        size_t count = 0;
+        double max = 0.0;
+
+        void on_temperature(const TemperatureChanged& event)
+        {
+            ++count;
+            max = std::max(max, event.temperature);
+        }
+    };
+}
+
+TEST_CASE("EventBus - typed delivery")
+{
+    TypedEvents::SensorBus bus;
+    TypedEvents::TempMonitor monitor{bus};
+
+    TypedEvents::Logger logger;
+    TypedEvents::Statistics stats;
+    int failures = 0;
+    auto on_failure = [&failures](const TypedEvents::SensorFailure& event) { failures += event.error_code; };
+
+    bus.subscribe<TypedEvents::TemperatureChanged, &TypedEvents::Logger::on_temperature>(logger);
+    const auto stats_id = bus.subscribe<TypedEvents::TemperatureChanged, &TypedEvents::Statistics::on_temperature>(stats);
+    bus.subscribe<TypedEvents::SensorFailure>(on_failure);
+
+    REQUIRE(bus.subscriber_count<TypedEvents::TemperatureChanged>() == 2);
+    REQUIRE(bus.subscriber_count<TypedEvents::SensorFailure>() == 1);
+
+    SECTION("publish delivers to subscribers of the event type only")
+    {
+        monitor.notify();
+        bus.publish(TypedEvents::SensorFailure{&monitor, 42});
+
+        REQUIRE(logger.log == vector{"23.880000"s});
+        REQUIRE(stats.count == 1);
+        REQUIRE(failures == 42);
+    }
+
+    SECTION("unsubscribe")
+    {
+        REQUIRE(bus.unsubscribe(stats_id));
+        REQUIRE_FALSE(bus.unsubscribe(stats_id));
+
+        monitor.notify();
+
+        REQUIRE(stats.count == 0);
+        REQUIRE(logger.log.size() == 1);
+    }
+
+    SECTION("posted events are delivered in batches by dispatch")
+    {
+        monitor.set_temp(20.0);
+        monitor.set_temp(25.0);
+        monitor.set_temp(22.0);
+
+        REQUIRE(bus.pending_count<TypedEvents::TemperatureChanged>() == 3);
+        REQUIRE(stats.count == 0);
+
+        bus.dispatch();
+
+        REQUIRE(bus.pending_count<TypedEvents::TemperatureChanged>() == 0);
+        REQUIRE(stats.count == 3);
+        REQUIRE(stats.max == 25.0);
+        REQUIRE(logger.log == vector{"20.000000"s, "25.000000"s, "22.000000"s});
+    }
+
+    SECTION("events posted by handlers wait for the next dispatch")
+    {
+        // readings of 100 or more are posted again reduced by 100 - three times, so the queue has to grow
+        auto repost = [&bus, &monitor](const TypedEvents::TemperatureChanged& event) {
+            if (event.temperature >= 100.0)
+                for (int i = 0; i < 3; ++i)
+                    bus.post(TypedEvents::TemperatureChanged{&monitor, event.temperature - 100.0});
+        };
+        bus.subscribe<TypedEvents::TemperatureChanged>(repost);
+
+        monitor.set_temp(150.0);
+        bus.dispatch();
+
+        REQUIRE(stats.count == 1);
+        REQUIRE(bus.pending_count<TypedEvents::TemperatureChanged>() == 3);
+
+        bus.dispatch();
+
+        REQUIRE(stats.count == 4);
+        REQUIRE(bus.pending_count<TypedEvents::TemperatureChanged>() == 0);
+        REQUIRE(logger.log == vector{"150.000000"s, "50.000000"s, "50.000000"s, "50.000000"s});
+    }
+}
+
+TEST_CASE("EventBus - publishing does not allocate")
+{
+    TypedEvents::SensorBus bus;
+    TypedEvents::TempMonitor monitor{bus};
+    std::vector<TypedEvents::Statistics> stats(10);
+    for (auto& s : stats)
+        bus.subscribe<TypedEvents::TemperatureChanged, &TypedEvents::Statistics::on_temperature>(s);
+
+    for (double temp : {1.0, 1.5}) // pending and delivering queues are swapped - both get their capacity
+    {
+        monitor.set_temp(temp);
+        bus.dispatch();
+    }
+
+    REQUIRE(count_allocations([&] {
+        monitor.notify();
+        monitor.set_temp(2.0);
+        bus.dispatch();
+    }) == 0);
+
+    REQUIRE(stats[9].count == 4);
+}
+
+namespace
+{
+    struct CountingObserver : Observer
+    {
+        size_t count = 0;
+
+        void update(const std::any& sender, const string& msg) override
+        {
+            if (std::any_cast<TempMonitor*>(&sender))
+                count += msg.size();
+        }
+    };
+
+    struct CountingSubscriber
+    {
+        size_t count = 0;
+
+        void on_temperature(const TypedEvents::TemperatureChanged& event)
+        {
+            if (event.sender)
+                count += 1;
+        }
+    };
+}
+
+TEST_CASE("EventBus - benchmark", "[.][benchmark]")
+{
+    for (size_t observer_count : {1, 10, 100, 1000})
+    {
+        std::vector<CountingObserver> observers(observer_count);
+        TempMonitor monitor;
+        for (auto& o : observers)
+            monitor.attach(&o);
+
+        TypedEvents::SensorBus bus;
+        TypedEvents::TempMonitor typed_monitor{bus};
+        std::vector<CountingSubscriber> subscribers(observer_count);
+        for (auto& s : subscribers)
+            bus.subscribe<TypedEvents::TemperatureChanged, &CountingSubscriber::on_temperature>(s);
+
+        BENCHMARK("Observer(std::any, string) - " + std::to_string(observer_count) + " observers")
+        {
+            monitor.notify();
+            return observers.back().count;
+        };
+
+        BENCHMARK("EventBus::publish - " + std::to_string(observer_count) + " observers")
+        {
+            typed_monitor.notify();
+            return subscribers.back().count;
+        };
+
+        BENCHMARK("EventBus::post x 16 + dispatch - " + std::to_string(observer_count) + " observers")
+        {
+            for (int i = 0; i < 16; ++i)
+                typed_monitor.set_temp(i);
+            bus.dispatch();
+            return subscribers.back().count;
+        };
+    }
+}
+
+////////////////////////////////////
+// notifications from many sensor threads
+
+namespace
+{
+    struct AtomicCounter
+    {
+        std::atomic<size_t> count{0};
+
+        void on_temperature(const TypedEvents::TemperatureChanged&)
+        {
+            count.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    // unsubscribes itself on the first event
+    struct OneShotObserver
+    {
+        ObserverRegistry<TypedEvents::TemperatureChanged>& registry;
+        SubscriptionId id{};
+        std::atomic<size_t> count{0};
+
+        explicit OneShotObserver(ObserverRegistry<TypedEvents::TemperatureChanged>& registry)
+            : registry{registry}
+        {
+        }
+
+        void on_temperature(const TypedEvents::TemperatureChanged&)
+        {
+            if (count.fetch_add(1) == 0)
+                registry.unsubscribe(id);
+        }
+    };
+
+    struct SlowObserver
+    {
+        size_t count = 0;
+
+        void on_temperature(const TypedEvents::TemperatureChanged&)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            while (std::chrono::steady_clock::now() - start < 2us)
+                ;
+            ++count;
+        }
+    };
+}
+
+TEST_CASE("ObserverRegistry")
+{
+    using TypedEvents::TemperatureChanged;
+
+    ObserverRegistry<TemperatureChanged> observers;
+    TypedEvents::Statistics stats;
+
+    const auto id = observers.subscribe<&TypedEvents::Statistics::on_temperature>(stats);
+    REQUIRE(observers.subscriber_count() == 1);
+
+    observers.publish(TemperatureChanged{nullptr, 21.5});
+    REQUIRE(stats.max == 21.5);
+
+    REQUIRE(observers.unsubscribe(id));
+    REQUIRE_FALSE(observers.unsubscribe(id));
+
+    observers.publish(TemperatureChanged{nullptr, 30.0});
+    REQUIRE(stats.count == 1);
+}
+
+TEST_CASE("ObserverRegistry - publishing from many threads while observers change")
+{
+    using TypedEvents::TemperatureChanged;
+
+    constexpr size_t producer_count = 4;
+    constexpr size_t events_per_producer = 20'000;
+
+    ObserverRegistry<TemperatureChanged> observers;
+    AtomicCounter permanent;
+    observers.subscribe<&AtomicCounter::on_temperature>(permanent);
+
+    std::atomic<bool> publishing{true};
+    std::thread churn{[&] {
+        while (publishing)
+        {
+            AtomicCounter temporary;
+            const auto id = observers.subscribe<&AtomicCounter::on_temperature>(temporary);
+            observers.unsubscribe(id); // temporary may be destroyed right after this
+        }
+    }};
+
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < producer_count; ++i)
+        producers.emplace_back([&] {
+            for (size_t n = 0; n < events_per_producer; ++n)
+                observers.publish(TemperatureChanged{nullptr, static_cast<double>(n)});
+        });
+
+    for (auto& p : producers)
+        p.join();
+    publishing = false;
+    churn.join();
+
+    REQUIRE(permanent.count == producer_count * events_per_producer);
+    REQUIRE(observers.subscriber_count() == 1);
+}
+
+TEST_CASE("ObserverRegistry - handlers unsubscribing during publish")
+{
+    using TypedEvents::TemperatureChanged;
+
+    ObserverRegistry<TemperatureChanged> observers;
+    AtomicCounter permanent;
+    observers.subscribe<&AtomicCounter::on_temperature>(permanent);
+
+    SECTION("single thread")
+    {
+        OneShotObserver first{observers}, second{observers};
+        first.id = observers.subscribe<&OneShotObserver::on_temperature>(first);
+        second.id = observers.subscribe<&OneShotObserver::on_temperature>(second);
+
+        observers.publish(TemperatureChanged{nullptr, 1.0});
+        observers.publish(TemperatureChanged{nullptr, 2.0});
+
+        REQUIRE(first.count == 1);
+        REQUIRE(second.count == 1);
+        REQUIRE(permanent.count == 2);
+        REQUIRE(observers.subscriber_count() == 1);
+    }
+
+    SECTION("many publishing threads")
+    {
+        constexpr size_t producer_count = 4;
+        constexpr size_t events_per_producer = 10'000;
+
+        std::vector<std::unique_ptr<OneShotObserver>> one_shots;
+        for (int i = 0; i < 100; ++i)
+        {
+            one_shots.push_back(std::make_unique<OneShotObserver>(observers));
+            one_shots.back()->id = observers.subscribe<&OneShotObserver::on_temperature>(*one_shots.back());
+        }
+
+        std::vector<std::thread> producers;
+        for (size_t i = 0; i < producer_count; ++i)
+            producers.emplace_back([&] {
+                for (size_t n = 0; n < events_per_producer; ++n)
+                    observers.publish(TemperatureChanged{nullptr, static_cast<double>(n)});
+            });
+
+        // a waiting unsubscribe is not starved by the publishers
+        AtomicCounter temporary;
+        observers.unsubscribe(observers.subscribe<&AtomicCounter::on_temperature>(temporary));
+
+        for (auto& p : producers)
+            p.join();
+
+        REQUIRE(permanent.count == producer_count * events_per_producer);
+        REQUIRE(observers.subscriber_count() == 1);
+        REQUIRE(std::all_of(one_shots.begin(), one_shots.end(), [](const auto& o) { return o->count >= 1; }));
+    }
+}
+
+TEST_CASE("BoundedQueue")
+{
+    BoundedQueue<int> queue{3};
+    REQUIRE(queue.capacity() == 4);
+
+    for (int i = 0; i < 4; ++i)
+        REQUIRE(queue.try_push(i));
+    REQUIRE_FALSE(queue.try_push(4));
+
+    int value;
+    for (int i = 0; i < 4; ++i)
+    {
+        REQUIRE(queue.try_pop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(queue.try_pop(value));
+}
+
+TEST_CASE("AsyncSubscriber - slow observer runs on its own thread")
+{
+    using TypedEvents::TemperatureChanged;
+
+    ObserverRegistry<TemperatureChanged> observers;
+
+    SECTION("all events are delivered")
+    {
+        SlowObserver slow;
+        AsyncSubscriber<TemperatureChanged> async_slow{EventHandler<TemperatureChanged>::bind<&SlowObserver::on_temperature>(slow), 1024};
+        const auto id = observers.subscribe(async_slow.handler());
+
+        for (int i = 0; i < 1000; ++i)
+            observers.publish(TemperatureChanged{nullptr, 1.0 * i});
+
+        observers.unsubscribe(id);
+        async_slow.stop();
+
+        REQUIRE(slow.count == 1000);
+        REQUIRE(async_slow.dropped_count() == 0);
+    }
+
+    SECTION("full queue drops events instead of blocking the publisher")
+    {
+        SlowObserver slow;
+        AsyncSubscriber<TemperatureChanged> async_slow{EventHandler<TemperatureChanged>::bind<&SlowObserver::on_temperature>(slow), 16};
+        const auto id = observers.subscribe(async_slow.handler());
+
+        for (int i = 0; i < 10'000; ++i)
+            observers.publish(TemperatureChanged{nullptr, 1.0 * i});
+
+        observers.unsubscribe(id);
+        async_slow.stop();
+
+        REQUIRE(async_slow.dropped_count() > 0);
+        REQUIRE(slow.count + async_slow.dropped_count() == 10'000);
+    }
+
+    SECTION("idle worker sleeps - it does not spin while there are no events")
+    {
+        AtomicCounter counter;
+        AsyncSubscriber<TemperatureChanged> async_counter{EventHandler<TemperatureChanged>::bind<&AtomicCounter::on_temperature>(counter)};
+        const auto id = observers.subscribe(async_counter.handler());
+
+        auto wait_for_sleep = [&async_counter](size_t sleep_count) {
+            while (async_counter.sleep_count() < sleep_count)
+                std::this_thread::yield();
+        };
+
+        for (size_t round = 1; round <= 3; ++round)
+        {
+            wait_for_sleep(round); // worker blocks once per batch of events
+
+            std::this_thread::sleep_for(10ms);
+            REQUIRE(async_counter.is_sleeping());
+            REQUIRE(async_counter.sleep_count() == round); // no wake-ups without events
+
+            observers.publish(TemperatureChanged{nullptr, 1.0 * round});
+        }
+
+        wait_for_sleep(4);
+        REQUIRE(counter.count == 3);
+
+        observers.unsubscribe(id);
+        async_counter.stop();
+
+        REQUIRE_FALSE(async_counter.is_sleeping());
+    }
+}
+
+TEST_CASE("ObserverRegistry - benchmark", "[.][benchmark]")
+{
+    using TypedEvents::TemperatureChanged;
+
+    AtomicCounter fast;
+    SlowObserver slow;
+
+    ObserverRegistry<TemperatureChanged> sync_observers;
+    sync_observers.subscribe<&AtomicCounter::on_temperature>(fast);
+    sync_observers.subscribe<&SlowObserver::on_temperature>(slow);
+
+    AsyncSubscriber<TemperatureChanged> async_slow{EventHandler<TemperatureChanged>::bind<&SlowObserver::on_temperature>(slow), 1 << 16};
+    ObserverRegistry<TemperatureChanged> async_observers;
+    async_observers.subscribe<&AtomicCounter::on_temperature>(fast);
+    const auto async_id = async_observers.subscribe(async_slow.handler());
+
+    BENCHMARK("publish - slow observer called synchronously")
+    {
+        sync_observers.publish(TemperatureChanged{nullptr, 23.88});
+    };
+
+    BENCHMARK("publish - slow observer behind a queue")
+    {
+        async_observers.publish(TemperatureChanged{nullptr, 23.88});
+    };
+
+    async_observers.unsubscribe(async_id);
+}
+
+////////////////////////////////////
+// coalescing monitor for many sensors
+
+namespace
+{
+    struct FrameRecorder
+    {
+        size_t frame_count = 0;
+        std::vector<SensorReading> readings;
+
+        void on_frame(const CoalescingMonitor<>::Frame& frame)
+        {
+            ++frame_count;
+            readings.insert(readings.end(), frame.begin(), frame.end());
+        }
+    };
+}
+
+bool operator==(const SensorReading& lhs, const SensorReading& rhs)
+{
+    return lhs.sensor_id == rhs.sensor_id && lhs.value == rhs.value;
+}
+
+TEST_CASE("CoalescingMonitor")
+{
+    const auto start = std::chrono::steady_clock::time_point{};
+    CoalescingMonitor<> monitor{3, 0.5, 100ms, start};
+
+    FrameRecorder recorder;
+    monitor.observers().subscribe<CoalescingMonitor<>::Frame, &FrameRecorder::on_frame>(recorder);
+
+    SECTION("only the latest reading in an interval is delivered")
+    {
+        monitor.record(0, 20.0);
+        monitor.record(0, 21.0);
+        monitor.record(1, 30.0);
+        monitor.record(0, 22.0);
+
+        REQUIRE_FALSE(monitor.tick(start + 50ms));
+        REQUIRE(recorder.frame_count == 0);
+
+        REQUIRE(monitor.tick(start + 100ms));
+        REQUIRE(recorder.frame_count == 1);
+        REQUIRE(recorder.readings == vector{SensorReading{0, 22.0}, SensorReading{1, 30.0}});
+
+        REQUIRE(monitor.received_count() == 4);
+        REQUIRE(monitor.delivered_count() == 2);
+    }
+
+    SECTION("readings within the deadband are suppressed")
+    {
+        monitor.record(2, 10.0);
+        monitor.tick(start + 100ms);
+
+        monitor.record(2, 10.3);
+        monitor.tick(start + 200ms);
+        REQUIRE(recorder.frame_count == 1); // empty frames are not published
+
+        monitor.record(2, 10.6);
+        monitor.tick(start + 300ms);
+        REQUIRE(recorder.frame_count == 2);
+        REQUIRE(recorder.readings.back() == SensorReading{2, 10.6});
+        REQUIRE(monitor.delivered_value(2) == 10.6);
+    }
+
+    SECTION("unchanged readings are not delivered again")
+    {
+        CoalescingMonitor<> exact{1, 0.0, 100ms, start};
+        FrameRecorder exact_recorder;
+        exact.observers().subscribe<CoalescingMonitor<>::Frame, &FrameRecorder::on_frame>(exact_recorder);
+
+        exact.record(0, 1.0);
+        exact.flush();
+        exact.record(0, 1.0);
+        exact.flush();
+
+        REQUIRE(exact_recorder.frame_count == 1);
+    }
+
+    SECTION("late tick skips missed intervals")
+    {
+        monitor.record(0, 1.0);
+        REQUIRE(monitor.tick(start + 450ms));
+        REQUIRE_FALSE(monitor.tick(start + 500ms));
+        REQUIRE(monitor.tick(start + 550ms));
+    }
+}
+
+TEST_CASE("CoalescingMonitor - thousands of sensors")
+{
+    constexpr uint32_t sensor_count = 5000;
+    constexpr int readings_per_interval = 20;
+
+    const auto start = std::chrono::steady_clock::time_point{};
+    CoalescingMonitor<> monitor{sensor_count, 0.5, 1s, start};
+
+    size_t observer_calls = 0;
+    auto on_frame = [&observer_calls](const CoalescingMonitor<>::Frame&) { ++observer_calls; };
+    monitor.observers().subscribe<CoalescingMonitor<>::Frame>(on_frame);
+
+    // noise within the deadband - only the first reading of each sensor passes
+    const size_t allocations = count_allocations([&] {
+        for (int interval = 1; interval <= 10; ++interval)
+        {
+            for (int i = 0; i < readings_per_interval; ++i)
+                for (uint32_t sensor = 0; sensor < sensor_count; ++sensor)
+                    monitor.record(sensor, 20.0 + 0.1 * (i % 3));
+            monitor.tick(start + interval * 1s);
+        }
+    });
+
+    REQUIRE(allocations == 0);
+    REQUIRE(monitor.received_count() == 10 * readings_per_interval * sensor_count);
+    REQUIRE(monitor.delivered_count() == sensor_count);
+    REQUIRE(observer_calls == 1);
+}
+
+TEST_CASE("CoalescingMonitor - benchmark", "[.][benchmark]")
+{
+    constexpr uint32_t sensor_count = 1000;
+    constexpr size_t observer_count = 10;
+
+    std::vector<CountingSubscriber> subscribers(observer_count);
+
+    TypedEvents::SensorBus bus;
+    for (auto& s : subscribers)
+        bus.subscribe<TypedEvents::TemperatureChanged, &CountingSubscriber::on_temperature>(s);
+
+    size_t frame_readings = 0;
+    auto on_frame = [&frame_readings](const CoalescingMonitor<>::Frame& frame) { frame_readings += frame.count; };
+
+    CoalescingMonitor<> monitor{sensor_count, 0.5, 1ms};
+    for (size_t i = 0; i < observer_count; ++i)
+        monitor.observers().subscribe<CoalescingMonitor<>::Frame>(on_frame);
+
+    TypedEvents::TempMonitor sensor_monitor{bus};
+
+    BENCHMARK("broadcast every reading - 1000 sensors x 10 readings, 10 observers")
+    {
+        for (int i = 0; i < 10; ++i)
+            for (uint32_t sensor = 0; sensor < sensor_count; ++sensor)
+                bus.publish(TypedEvents::TemperatureChanged{&sensor_monitor, 20.0 + 0.1 * (i % 3)});
+        return subscribers.back().count;
+    };
+
+    BENCHMARK("coalesced frame - 1000 sensors x 10 readings, 10 observers")
+    {
+        for (int i = 0; i < 10; ++i)
+            for (uint32_t sensor = 0; sensor < sensor_count; ++sensor)
+                monitor.record(sensor, 20.0 + 0.1 * (i % 3));
+        monitor.flush();
+        return frame_readings;
+    };
+}
@@ -0,0 +1,112 @@
+#ifndef TYPE_ID_HPP
+#define TYPE_ID_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+// type identity without RTTI - works with -fno-rtti
+// each type gets the address of its own static variable; comparing ids is a pointer compare
+// (in programs split into shared libraries the variables must have default visibility to be unique)
+class TypeId
+{
+    const void* id_;
+    std::string_view name_;
+
+    constexpr TypeId(const void* id, std::string_view name) noexcept
+        : id_{id}, name_{name}
+    {
+    }
+
+    template <typename T>
+    friend constexpr TypeId type_id() noexcept;
+
+public:
+    constexpr std::string_view name() const noexcept
+    {
+        return name_;
+    }
+
+    constexpr const void* address() const noexcept
+    {
+        return id_;
+    }
+
+    friend constexpr bool operator==(const TypeId& lhs, const TypeId& rhs) noexcept
+    {
+        return lhs.id_ == rhs.id_;
+    }
+
+    friend constexpr bool operator!=(const TypeId& lhs, const TypeId& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const TypeId& lhs, const TypeId& rhs) noexcept
+    {
+        return std::less<const void*>{}(lhs.id_, rhs.id_);
+    }
+};
+
+namespace TypeIdDetails
+{
+    // mutable on purpose - identical constants may be folded into one object
+    // (MSVC /OPT:ICF, -fmerge-all-constants, --icf=all) and all ids would compare equal
+    template <typename T>
+    struct Tag
+    {
+        inline static char id;
+    };
+
+    // name extracted from the signature of the function - no RTTI needed
+    template <typename T>
+    constexpr std::string_view type_name() noexcept
+    {
+#if defined(__clang__)
+        constexpr std::string_view signature = __PRETTY_FUNCTION__;
+        constexpr std::string_view prefix = "[T = ";
+        constexpr std::string_view suffix = "]";
+#elif defined(__GNUC__)
+        constexpr std::string_view signature = __PRETTY_FUNCTION__;
+        constexpr std::string_view prefix = "[with T = ";
+        constexpr std::string_view suffix = ";";
+#elif defined(_MSC_VER)
+        constexpr std::string_view signature = __FUNCSIG__;
+        constexpr std::string_view prefix = "type_name<";
+        constexpr std::string_view suffix = ">(void)";
+#else
+        constexpr std::string_view signature = "";
+        constexpr std::string_view prefix = "";
+        constexpr std::string_view suffix = "";
+#endif
+        const size_t start = signature.find(prefix);
+        if (prefix.empty() || start == std::string_view::npos)
+            return "<unknown type>";
+
+        const size_t name_start = start + prefix.size();
+        const size_t name_end = signature.find(suffix, name_start);
+
+        return signature.substr(name_start, name_end - name_start);
+    }
+}
+
+// as typeid - top-level references and cv-qualifiers are ignored
+template <typename T>
+constexpr TypeId type_id() noexcept
+{
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+
+    return TypeId{&TypeIdDetails::Tag<U>::id, TypeIdDetails::type_name<U>()};
+}
+
+template <>
+struct std::hash<TypeId>
+{
+    size_t operator()(const TypeId& id) const noexcept
+    {
+        return std::hash<const void*>{}(id.address());
+    }
+};
+
+#endif // TYPE_ID_HPP
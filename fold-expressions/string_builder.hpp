@@ -0,0 +1,152 @@
+#ifndef STRING_BUILDER_HPP
+#define STRING_BUILDER_HPP
+
+#include <charconv>
+#include <deque>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// collects pieces of text (appended or prepended in O(1)) and materializes them once
+class StringBuilder
+{
+    // text is either external (view passed to append_view/prepend_view)
+    // or owned - stored in storage_ at given offset
+    struct Piece
+    {
+        const char* external;
+        size_t offset;
+        size_t length;
+    };
+
+    std::deque<Piece> pieces_;
+    std::string storage_;
+    size_t size_ = 0;
+
+    // everything is copied - the builder never refers to temporaries or buffers of the caller
+    // (a const char array is not necessarily a string literal)
+    template <typename T>
+    Piece make_piece(const T& value)
+    {
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, bool>)
+        {
+            char digits[64];
+            auto [ptr, ec] = std::to_chars(std::begin(digits), std::end(digits), value);
+            return make_owned(std::string_view(digits, ptr - digits));
+        }
+        else if constexpr (std::is_same_v<T, char>)
+        {
+            return make_owned(std::string_view(&value, 1));
+        }
+        else
+        {
+            static_assert(std::is_convertible_v<const T&, std::string_view>, "StringBuilder - unsupported type");
+
+            return make_owned(value);
+        }
+    }
+
+    static Piece make_external(std::string_view text) noexcept
+    {
+        return Piece{text.data(), 0, text.size()};
+    }
+
+    StringBuilder& push_back(Piece piece)
+    {
+        pieces_.push_back(piece);
+        size_ += piece.length;
+        return *this;
+    }
+
+    StringBuilder& push_front(Piece piece)
+    {
+        pieces_.push_front(piece);
+        size_ += piece.length;
+        return *this;
+    }
+
+    Piece make_owned(std::string_view text)
+    {
+        Piece piece{nullptr, storage_.size(), text.size()};
+        storage_.append(text);
+        return piece;
+    }
+
+    std::string_view text_of(const Piece& piece) const
+    {
+        return piece.external ? std::string_view(piece.external, piece.length)
+                              : std::string_view(storage_).substr(piece.offset, piece.length);
+    }
+
+public:
+    StringBuilder() = default;
+
+    explicit StringBuilder(std::string_view text)
+    {
+        append(text);
+    }
+
+    explicit StringBuilder(std::string text)
+        : storage_{std::move(text)}
+    {
+        push_back(Piece{nullptr, 0, storage_.size()});
+    }
+
+    explicit StringBuilder(const char* text)
+        : StringBuilder(std::string_view(text))
+    {
+    }
+
+    template <typename T>
+    StringBuilder& append(T&& value)
+    {
+        return push_back(make_piece(value));
+    }
+
+    template <typename T>
+    StringBuilder& prepend(T&& value)
+    {
+        return push_front(make_piece(value));
+    }
+
+    // opt-in for long-lived text (e.g. string literals) - no copy, text must outlive the builder
+    StringBuilder& append_view(std::string_view text)
+    {
+        return push_back(make_external(text));
+    }
+
+    StringBuilder& prepend_view(std::string_view text)
+    {
+        return push_front(make_external(text));
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    std::string str() const
+    {
+        std::string result;
+        result.reserve(size_);
+
+        for (const auto& piece : pieces_)
+            result.append(text_of(piece));
+
+        return result;
+    }
+};
+
+// as std::accumulate - op(StringBuilder&, const Item&) adds pieces for every item
+template <typename TIterator, typename TOp>
+std::string accumulate_string(TIterator first, TIterator last, StringBuilder builder, TOp op)
+{
+    for (; first != last; ++first)
+        op(builder, *first);
+
+    return builder.str();
+}
+
+#endif // STRING_BUILDER_HPP
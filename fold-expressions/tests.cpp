@@ -1,15 +1,48 @@
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <charconv>
+#include <cstdio>
+#include <functional>
+#include <future>
 #include <numeric>
+#include <optional>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include "catch.hpp"
+#include "string_builder.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FAST_PRINT_POSIX 1
+#include <cerrno>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
 namespace Cpp98
 {
+    // "(((0 + 1) + 2) + 3)" - pieces are collected and the string is built once (linear time)
+    std::string fold_to_string(const std::vector<int>& vec)
+    {
+        return accumulate_string(std::begin(vec), std::end(vec), StringBuilder{"0"},
+            [](StringBuilder& reduced, int item) {
+                reduced.prepend("(").append(" + ").append(item).append(")");
+            });
+    }
+
     void fold_98()
     {
         std::vector<int> vec = {1, 2, 3, 4, 5};
@@ -17,10 +50,7 @@ namespace Cpp98
         auto sum = std::accumulate(std::begin(vec), std::end(vec), 0);
         std::cout << "sum: " << sum << "\n";
 
-        auto result = std::accumulate(std::begin(vec), std::end(vec), "0"s,
-            [](const std::string& reduced, int item) {
-                return "("s + reduced + " + "s + std::to_string(item) + ")"s;
-            });
+        auto result = fold_to_string(vec);
 
         std::cout << result << "\n";
     }
@@ -29,6 +59,74 @@ namespace Cpp98
 TEST_CASE("fold expressions")
 {
     Cpp98::fold_98();
+
+    REQUIRE(Cpp98::fold_to_string({1, 2, 3}) == "(((0 + 1) + 2) + 3)");
+    REQUIRE(Cpp98::fold_to_string({}) == "0");
+}
+
+TEST_CASE("StringBuilder")
+{
+    StringBuilder builder;
+
+    std::string text = "text";
+    builder.append(text).append(' ').append(42).append(" ").append(-1.5).prepend("> ");
+    text = "changed"; // std::string is copied
+
+    REQUIRE(builder.size() == 14);
+    REQUIRE(builder.str() == "> text 42 -1.5");
+
+    SECTION("only views passed to append_view/prepend_view are not copied")
+    {
+        StringBuilder copies{std::to_string(123)};
+
+        {
+            std::string temp = "temp";
+            char buffer[16] = "buffer";
+            const char const_buffer[] = "const";
+
+            copies.append(' ').append(temp.c_str()).append(std::string_view{temp}).append(buffer).append(const_buffer).prepend(temp + "!");
+
+            temp = "xxxx";
+            buffer[0] = 'X';
+        }
+
+        REQUIRE(copies.str() == "temp!123 temptempbufferconst");
+
+        static const std::string long_lived = "long lived";
+        StringBuilder views;
+        views.append_view(long_lived).prepend_view("[").append("]");
+
+        REQUIRE(views.str() == "[long lived]");
+    }
+
+    SECTION("many items")
+    {
+        std::vector<int> vec(10'000, 7); // timing - see "fold to string - benchmark"
+
+        auto result = Cpp98::fold_to_string(vec);
+
+        REQUIRE(result.size() == 1 + 10'000 * "( + 7)"s.size());
+        REQUIRE(result.substr(result.size() - 10) == " + 7) + 7)");
+    }
+}
+
+TEST_CASE("fold to string - benchmark", "[.][benchmark]")
+{
+    std::vector<int> vec(20'000);
+    std::iota(begin(vec), end(vec), 0);
+
+    BENCHMARK("std::accumulate + operator+")
+    {
+        return std::accumulate(std::begin(vec), std::end(vec), "0"s,
+            [](const std::string& reduced, int item) {
+                return "("s + reduced + " + "s + std::to_string(item) + ")"s;
+            });
+    };
+
+    BENCHMARK("accumulate_string + StringBuilder")
+    {
+        return Cpp98::fold_to_string(vec);
+    };
 }
 
 namespace BeforeCpp17
@@ -86,4 +184,885 @@ TEST_CASE("fold + variadic templates")
     print(1, 3.14, "text", "abc"s);
 
     print_lines(1, 3.14, "text", "abc"s);
-}
\ No newline at end of file
+}
+
+////////////////////////////////////////
+// buffered printing - no iostreams
+
+namespace FastPrint
+{
+    template <typename T>
+    constexpr bool always_false = false;
+
+    // operator<< prints all three char types as characters
+    template <typename T>
+    constexpr bool is_char_v = std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>;
+
+    template <typename T>
+    void append(std::string& buffer, const T& arg)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            buffer.push_back(arg ? '1' : '0');
+        }
+        else if constexpr (is_char_v<T>)
+        {
+            buffer.push_back(static_cast<char>(arg));
+        }
+        else if constexpr (std::is_arithmetic_v<T>)
+        {
+            char digits[64];
+            std::to_chars_result result;
+
+            if constexpr (std::is_floating_point_v<T>)
+                result = std::to_chars(std::begin(digits), std::end(digits), arg, std::chars_format::general, 6); // as std::cout
+            else
+                result = std::to_chars(std::begin(digits), std::end(digits), arg);
+
+            buffer.append(digits, result.ptr);
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        {
+            buffer.append(std::string_view(arg));
+        }
+        else
+        {
+            static_assert(always_false<T>, "FastPrint - unsupported type of argument");
+        }
+    }
+
+    inline std::string& thread_buffer()
+    {
+        thread_local std::string buffer;
+        buffer.clear();
+
+        return buffer;
+    }
+
+    // bypasses stdio - flush stdout/std::cout first when mixing them with fast_print
+    inline void flush(const std::string& buffer)
+    {
+#ifdef FAST_PRINT_POSIX
+        const char* data = buffer.data();
+        size_t size = buffer.size();
+
+        while (size > 0) // one write() unless it is interrupted or partial
+        {
+            const ssize_t written = ::write(STDOUT_FILENO, data, size);
+
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return;
+            }
+
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+#else
+        std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+        std::fflush(stdout);
+#endif
+    }
+}
+
+// appends args separated with spaces - the same output as print(args...) without the line break
+template <typename... TArgs>
+void append_to(std::string& buffer, const TArgs&... args)
+{
+    bool is_first = true;
+
+    auto with_space = [&](const auto& arg) {
+        if (!is_first)
+            buffer.push_back(' ');
+        is_first = false;
+        FastPrint::append(buffer, arg);
+    };
+
+    (..., with_space(args));
+}
+
+template <typename... TArgs>
+void fast_print(const TArgs&... args)
+{
+    std::string& buffer = FastPrint::thread_buffer();
+
+    append_to(buffer, args...);
+    buffer.push_back('\n');
+
+    FastPrint::flush(buffer); // one write per line
+}
+
+template <typename... TArgs>
+void fast_print_lines(const TArgs&... args)
+{
+    std::string& buffer = FastPrint::thread_buffer();
+
+    (..., (FastPrint::append(buffer, args), buffer.push_back('\n')));
+
+    FastPrint::flush(buffer); // one write per batch
+}
+
+TEST_CASE("fast_print")
+{
+    std::string buffer;
+
+    append_to(buffer, 1, 3.14, "text", "abc"s, 'x', true, -42L, 1.0 / 3, "sv"sv);
+
+    REQUIRE(buffer == "1 3.14 text abc x 1 -42 0.333333 sv");
+
+    SECTION("the same output as operator<<")
+    {
+        std::ostringstream out;
+        out << 1 << " " << 3.14 << " " << 1e20 << " " << 0.0001 << " " << 2.5f;
+
+        buffer.clear();
+        append_to(buffer, 1, 3.14, 1e20, 0.0001, 2.5f);
+
+        REQUIRE(buffer == out.str());
+    }
+
+    SECTION("char types as characters - as operator<<")
+    {
+        const signed char sc = 'a';
+        const unsigned char uc = 'b';
+
+        std::ostringstream out;
+        out << sc << " " << uc << " " << 'c' << " " << true;
+
+        buffer.clear();
+        append_to(buffer, sc, uc, 'c', true);
+
+        REQUIRE(buffer == "a b c 1");
+        REQUIRE(buffer == out.str());
+    }
+
+    std::cout << std::flush; // fast_print writes to the file descriptor directly
+    fast_print(1, 3.14, "text", "abc"s);
+    fast_print_lines(1, 3.14, "text", "abc"s);
+}
+
+TEST_CASE("fast_print - benchmark", "[.][benchmark]")
+{
+    BENCHMARK("fold with operator<<")
+    {
+        std::ostringstream out;
+        for (int i = 0; i < 1000; ++i)
+            out << i << " " << 3.14 << " " << "text" << " " << "abc"s << "\n";
+        return out.str().size();
+    };
+
+    BENCHMARK("append_to")
+    {
+        std::string buffer;
+        for (int i = 0; i < 1000; ++i)
+        {
+            append_to(buffer, i, 3.14, "text", "abc"s);
+            buffer.push_back('\n');
+        }
+        return buffer.size();
+    };
+}
+
+////////////////////////////////////////
+// format string parsed at compile time
+
+namespace CompileTimeFormat
+{
+    // literal text [text_begin, text_end) followed by an optional replacement field
+    struct Segment
+    {
+        size_t text_begin = 0;
+        size_t text_end = 0;
+        bool has_field = false;
+        char type = '\0'; // '\0' - default, 'd', 'x', 'f', 'e', 'g'
+        int precision = -1;
+    };
+
+    constexpr bool is_digit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    // errors in the format string make the evaluation not constant - compile error
+    template <size_t N>
+    constexpr std::array<Segment, N> parse(std::string_view fmt, size_t& segment_count)
+    {
+        std::array<Segment, N> segments{};
+        segment_count = 0;
+
+        auto next_segment = [&](size_t text_begin) -> Segment& {
+            if (segment_count == N)
+                throw "format string - too many segments";
+            Segment& segment = segments[segment_count++];
+            segment.text_begin = segment.text_end = text_begin;
+            return segment;
+        };
+
+        Segment* current = &next_segment(0);
+
+        for (size_t i = 0; i < fmt.size(); ++i)
+        {
+            if (fmt[i] == '}')
+            {
+                if (i + 1 == fmt.size() || fmt[i + 1] != '}')
+                    throw "format string - unmatched '}'";
+
+                current->text_end = i + 1; // keep one '}'
+                current = &next_segment(++i + 1);
+            }
+            else if (fmt[i] == '{')
+            {
+                if (i + 1 < fmt.size() && fmt[i + 1] == '{')
+                {
+                    current->text_end = i + 1; // keep one '{'
+                    current = &next_segment(++i + 1);
+                    continue;
+                }
+
+                current->text_end = i;
+                current->has_field = true;
+                ++i;
+
+                if (i < fmt.size() && fmt[i] == ':')
+                {
+                    ++i;
+
+                    if (i < fmt.size() && fmt[i] == '.')
+                    {
+                        ++i;
+                        if (i == fmt.size() || !is_digit(fmt[i]))
+                            throw "format string - precision expected";
+
+                        current->precision = 0;
+                        for (; i < fmt.size() && is_digit(fmt[i]); ++i)
+                            current->precision = current->precision * 10 + (fmt[i] - '0');
+                    }
+
+                    if (i < fmt.size() && fmt[i] != '}')
+                    {
+                        if (std::string_view{"dxfeg"}.find(fmt[i]) == std::string_view::npos)
+                            throw "format string - unknown type";
+                        current->type = fmt[i++];
+                    }
+                }
+
+                if (i == fmt.size() || fmt[i] != '}')
+                    throw "format string - '}' expected";
+
+                current = &next_segment(i + 1);
+            }
+            else
+            {
+                current->text_end = i + 1;
+            }
+        }
+
+        return segments;
+    }
+
+    constexpr size_t max_segments(std::string_view fmt)
+    {
+        size_t count = 1;
+        for (char c : fmt)
+            if (c == '{' || c == '}')
+                ++count;
+        return count;
+    }
+
+    template <size_t N>
+    struct Format
+    {
+        std::string_view text;
+        std::array<Segment, N> segments;
+        size_t segment_count;
+
+        constexpr size_t field_count() const
+        {
+            size_t count = 0;
+            for (size_t i = 0; i < segment_count; ++i)
+                count += segments[i].has_field;
+            return count;
+        }
+
+        // index of the argument used by the field in the segment
+        constexpr size_t arg_index(size_t segment_index) const
+        {
+            size_t index = 0;
+            for (size_t i = 0; i < segment_index; ++i)
+                index += segments[i].has_field;
+            return index;
+        }
+    };
+
+    // TFormat - constexpr lambda returning the format string, e.g. [] { return "{} {:.3f}"sv; }
+    template <typename TFormat>
+    constexpr auto parse_format(TFormat fmt)
+    {
+        constexpr std::string_view text = fmt();
+        constexpr size_t capacity = max_segments(text);
+
+        size_t segment_count = 0;
+        auto segments = parse<capacity>(text, segment_count);
+
+        return Format<capacity>{text, segments, segment_count};
+    }
+
+    constexpr int max_precision = 100;
+
+    // buffers are sized for the worst case - a failure here is a bug, not bad input
+    inline void check_to_chars(std::errc ec)
+    {
+        if (ec != std::errc{})
+            throw std::system_error{std::make_error_code(ec), "format_to"};
+    }
+
+    template <typename TFormat, size_t SegmentIndex, typename T>
+    void append_field(std::string& buffer, TFormat fmt, const T& arg)
+    {
+        constexpr Segment segment = parse_format(fmt).segments[SegmentIndex];
+
+        if constexpr (segment.type == 'd' || segment.type == 'x')
+        {
+            static_assert(std::is_integral_v<T>, "format string - {:d} and {:x} require an integral argument");
+
+            char digits[std::numeric_limits<T>::digits + 2]; // base 2 would fit too
+            auto [ptr, ec] = std::to_chars(std::begin(digits), std::end(digits), arg, segment.type == 'x' ? 16 : 10);
+            check_to_chars(ec);
+            buffer.append(digits, ptr);
+        }
+        else if constexpr (segment.type != '\0' || segment.precision >= 0)
+        {
+            static_assert(std::is_floating_point_v<T>, "format string - {:f}, {:e}, {:g} and precision require a floating point argument");
+            static_assert(segment.precision <= max_precision, "format string - precision is too large");
+
+            // no type with precision - general format (as in std::format)
+            constexpr auto format = segment.type == 'e'                             ? std::chars_format::scientific
+                                    : segment.type == 'g' || segment.type == '\0' ? std::chars_format::general
+                                                                                    : std::chars_format::fixed;
+            constexpr int precision = segment.precision >= 0 ? segment.precision : 6;
+
+            // the longest output is fixed format of the largest value: sign, integer digits, point, precision
+            // (scientific needs less - the exponent takes at most 7 chars)
+            char digits[std::numeric_limits<T>::max_exponent10 + precision + 16];
+            auto [ptr, ec] = std::to_chars(std::begin(digits), std::end(digits), arg, format, precision);
+            check_to_chars(ec);
+            buffer.append(digits, ptr);
+        }
+        else
+        {
+            FastPrint::append(buffer, arg);
+        }
+    }
+
+    template <typename TFormat, typename TArgsTuple, size_t... SegmentIndexes>
+    void format_segments(std::string& buffer, TFormat fmt, const TArgsTuple& args, std::index_sequence<SegmentIndexes...>)
+    {
+        constexpr auto format = parse_format(fmt);
+
+        auto append_segment = [&](auto segment_index) {
+            constexpr Segment segment = format.segments[segment_index];
+
+            buffer.append(format.text.substr(segment.text_begin, segment.text_end - segment.text_begin));
+
+            if constexpr (segment.has_field)
+                append_field<TFormat, segment_index>(buffer, fmt, std::get<format.arg_index(segment_index)>(args));
+        };
+
+        (..., append_segment(std::integral_constant<size_t, SegmentIndexes>{}));
+    }
+}
+
+// format string is parsed and validated during compilation - only formatting of arguments is left for runtime
+template <typename TFormat, typename... TArgs>
+void format_to(std::string& buffer, TFormat fmt, const TArgs&... args)
+{
+    constexpr auto format = CompileTimeFormat::parse_format(fmt);
+
+    static_assert(format.field_count() == sizeof...(TArgs), "format string - number of fields and arguments do not match");
+
+    CompileTimeFormat::format_segments(buffer, fmt, std::forward_as_tuple(args...), std::make_index_sequence<format.segment_count>{});
+}
+
+template <typename TFormat, typename... TArgs>
+void print_format(TFormat fmt, const TArgs&... args)
+{
+    std::string& buffer = FastPrint::thread_buffer();
+
+    format_to(buffer, fmt, args...);
+    buffer.push_back('\n');
+
+    FastPrint::flush(buffer);
+}
+
+TEST_CASE("format string parsed at compile time")
+{
+    constexpr auto format = CompileTimeFormat::parse_format([] { return "x = {}, pi = {:.3f}"sv; });
+
+    static_assert(format.field_count() == 2);
+    static_assert(format.segments[1].type == 'f' && format.segments[1].precision == 3);
+
+    std::string buffer;
+
+    format_to(buffer, [] { return "{} {:.3f} {} {}"sv; }, 1, 3.14159, "text", "abc"s);
+    REQUIRE(buffer == "1 3.142 text abc");
+
+    SECTION("types")
+    {
+        buffer.clear();
+        format_to(buffer, [] { return "{:x}|{:d}|{:e}|{:.2g}|{:f}"sv; }, 255, -7L, 1500.0, 0.000123, 2.5f);
+        REQUIRE(buffer == "ff|-7|1.500000e+03|0.00012|2.500000");
+    }
+
+    SECTION("precision without type - general format as in std::format")
+    {
+        buffer.clear();
+        format_to(buffer, [] { return "{:.3}|{:.3}"sv; }, 3.14159, 1234567.0);
+        REQUIRE(buffer == "3.14|1.23e+06");
+    }
+
+    SECTION("longest output")
+    {
+        buffer.clear();
+        format_to(buffer, [] { return "{:.100f}"sv; }, -std::numeric_limits<double>::max());
+        REQUIRE(buffer.size() == 1 + 309 + 1 + 100);
+        REQUIRE(buffer.substr(0, 4) == "-179");
+
+        buffer.clear();
+        format_to(buffer, [] { return "{:x}|{}"sv; }, std::numeric_limits<uint64_t>::max(), std::numeric_limits<int64_t>::min());
+        REQUIRE(buffer == "ffffffffffffffff|-9223372036854775808");
+    }
+
+    SECTION("escaped braces")
+    {
+        buffer.clear();
+        format_to(buffer, [] { return "{{{}}} }}"sv; }, 42);
+        REQUIRE(buffer == "{42} }");
+    }
+
+    SECTION("no fields")
+    {
+        buffer.clear();
+        format_to(buffer, [] { return "text"sv; });
+        REQUIRE(buffer == "text");
+    }
+
+    // errors detected during compilation:
+    // format_to(buffer, [] { return "{} {}"sv; }, 1);           // number of fields and arguments do not match
+    // format_to(buffer, [] { return "{:.2f}"sv; }, 1);          // precision requires a floating point argument
+    // format_to(buffer, [] { return "{:q}"sv; }, 1);            // unknown type
+    // format_to(buffer, [] { return "{:.600f}"sv; }, 1.0);      // precision is too large
+    // format_to(buffer, [] { return "}"sv; });                  // unmatched '}'
+
+    std::cout << std::flush; // print_format writes to the file descriptor directly
+    print_format([] { return "{} {:.2f} {}"sv; }, 1, 3.14159, "text");
+}
+
+TEST_CASE("format string - benchmark", "[.][benchmark]")
+{
+    BENCHMARK("snprintf")
+    {
+        char buffer[128];
+        return std::snprintf(buffer, sizeof(buffer), "%d %.3f %s", 42, 3.14159, "text");
+    };
+
+    BENCHMARK("format_to")
+    {
+        std::string& buffer = FastPrint::thread_buffer();
+        format_to(buffer, [] { return "{} {:.3f} {}"sv; }, 42, 3.14159, "text");
+        return buffer.size();
+    };
+}
+
+////////////////////////////////////////
+// expression templates - folds over vectors
+
+namespace ExpressionTemplates
+{
+    // CRTP base of all vector expressions
+    template <typename TExpr>
+    struct Expr
+    {
+        const TExpr& self() const
+        {
+            return static_cast<const TExpr&>(*this);
+        }
+    };
+
+    template <typename T>
+    class Vector : public Expr<Vector<T>>
+    {
+        std::vector<T> items_;
+
+    public:
+        using value_type = T;
+
+        explicit Vector(size_t size, const T& value = T{})
+            : items_(size, value)
+        {
+        }
+
+        Vector(std::initializer_list<T> il)
+            : items_(il)
+        {
+        }
+
+        // the whole expression is evaluated in one loop - no temporaries
+        template <typename TExpr>
+        Vector(const Expr<TExpr>& expr)
+            : items_(expr.self().size())
+        {
+            const TExpr& e = expr.self();
+            for (size_t i = 0; i < items_.size(); ++i)
+                items_[i] = e[i];
+        }
+
+        size_t size() const
+        {
+            return items_.size();
+        }
+
+        const T& operator[](size_t index) const
+        {
+            return items_[index];
+        }
+
+        T& operator[](size_t index)
+        {
+            return items_[index];
+        }
+
+        bool operator==(const Vector& other) const
+        {
+            return items_ == other.items_;
+        }
+    };
+
+    // vectors are stored by reference, subexpressions (temporaries) by value
+    template <typename TExpr>
+    struct Operand
+    {
+        using type = const TExpr;
+    };
+
+    template <typename T>
+    struct Operand<Vector<T>>
+    {
+        using type = const Vector<T>&;
+    };
+
+    template <typename TExpr>
+    using Operand_t = typename Operand<TExpr>::type;
+
+    template <typename TLeft, typename TRight, typename TOp>
+    class BinaryExpr : public Expr<BinaryExpr<TLeft, TRight, TOp>>
+    {
+        Operand_t<TLeft> lhs_;
+        Operand_t<TRight> rhs_;
+
+    public:
+        BinaryExpr(const TLeft& lhs, const TRight& rhs)
+            : lhs_{lhs}, rhs_{rhs}
+        {
+            assert(lhs.size() == rhs.size());
+        }
+
+        size_t size() const
+        {
+            return lhs_.size();
+        }
+
+        auto operator[](size_t index) const
+        {
+            return TOp{}(lhs_[index], rhs_[index]);
+        }
+    };
+
+    template <typename TLeft, typename TRight>
+    auto operator+(const Expr<TLeft>& lhs, const Expr<TRight>& rhs)
+    {
+        return BinaryExpr<TLeft, TRight, std::plus<>>{lhs.self(), rhs.self()};
+    }
+
+    template <typename TLeft, typename TRight>
+    auto operator*(const Expr<TLeft>& lhs, const Expr<TRight>& rhs)
+    {
+        return BinaryExpr<TLeft, TRight, std::multiplies<>>{lhs.self(), rhs.self()};
+    }
+}
+
+TEST_CASE("fold expressions over vectors")
+{
+    using ExpressionTemplates::Vector;
+
+    Vector<int> v1 = {1, 2, 3};
+    Vector<int> v2 = {10, 20, 30};
+    Vector<int> v3 = {100, 200, 300};
+
+    auto expr = sum(v1, v2, v3); // lazy - nothing is computed yet
+    static_assert(!std::is_same_v<decltype(expr), Vector<int>>);
+
+    Vector<int> result = expr;
+    REQUIRE(result == Vector<int>{111, 222, 333});
+
+    Vector<int> result_r = sum_r(v1, v2, v3);
+    REQUIRE(result_r == result);
+
+    Vector<int> mixed = v1 * v2 + v3;
+    REQUIRE(mixed == Vector<int>{110, 240, 390});
+}
+
+namespace Naive
+{
+    // operator+ creates temporary vector for every addition
+    struct Vector
+    {
+        std::vector<double> items;
+
+        friend Vector operator+(const Vector& lhs, const Vector& rhs)
+        {
+            Vector result{std::vector<double>(lhs.items.size())};
+            for (size_t i = 0; i < lhs.items.size(); ++i)
+                result.items[i] = lhs.items[i] + rhs.items[i];
+            return result;
+        }
+    };
+}
+
+TEST_CASE("fold expressions over vectors - benchmark", "[.][benchmark]")
+{
+    const size_t size = 1'000'000;
+
+    Naive::Vector n1{std::vector<double>(size, 1.0)}, n2 = n1, n3 = n1, n4 = n1;
+
+    BENCHMARK("sum of vectors - temporaries")
+    {
+        return sum(n1, n2, n3, n4);
+    };
+
+    ExpressionTemplates::Vector<double> v1(size, 1.0), v2 = v1, v3 = v1, v4 = v1;
+
+    BENCHMARK("sum of vectors - expression templates")
+    {
+        return ExpressionTemplates::Vector<double>(sum(v1, v2, v3, v4));
+    };
+}
+
+////////////////////////////////////////
+// tree folds - balanced reduction
+
+namespace Details
+{
+    template <size_t Offset, typename TOp, typename TTuple, size_t... Is>
+    constexpr auto tree_fold_range(TOp op, TTuple&& args, std::index_sequence<Is...>);
+}
+
+template <typename TOp, typename TArg>
+constexpr auto tree_fold(TOp, TArg&& arg)
+{
+    return std::forward<TArg>(arg);
+}
+
+// ((1 + 2) + (3 + 4)) instead of (((1 + 2) + 3) + 4) - op must be associative, may be non-commutative
+template <typename TOp, typename TArg1, typename TArg2, typename... TArgs>
+constexpr auto tree_fold(TOp op, TArg1&& arg1, TArg2&& arg2, TArgs&&... args)
+{
+    constexpr size_t size = 2 + sizeof...(TArgs);
+    constexpr size_t half = size / 2;
+
+    auto all_args = std::forward_as_tuple(std::forward<TArg1>(arg1), std::forward<TArg2>(arg2), std::forward<TArgs>(args)...);
+
+    return op(Details::tree_fold_range<0>(op, std::move(all_args), std::make_index_sequence<half>{}),
+              Details::tree_fold_range<half>(op, std::move(all_args), std::make_index_sequence<size - half>{}));
+}
+
+namespace Details
+{
+    template <size_t Offset, typename TOp, typename TTuple, size_t... Is>
+    constexpr auto tree_fold_range(TOp op, TTuple&& args, std::index_sequence<Is...>)
+    {
+        return tree_fold(op, std::get<Offset + Is>(std::forward<TTuple>(args))...);
+    }
+
+    // four independent accumulators over contiguous lanes - the order of items is preserved
+    template <typename T, typename TIterator, typename TOp>
+    T reduce_non_empty(TIterator first, size_t size, TOp op)
+    {
+        constexpr size_t lanes = 4;
+        const size_t lane_size = size / lanes;
+
+        if (lane_size == 0)
+        {
+            T result = first[0];
+            for (size_t i = 1; i < size; ++i)
+                result = op(std::move(result), first[i]);
+            return result;
+        }
+
+        T acc0 = first[0];
+        T acc1 = first[lane_size];
+        T acc2 = first[2 * lane_size];
+        T acc3 = first[3 * lane_size];
+
+        for (size_t i = 1; i < lane_size; ++i)
+        {
+            acc0 = op(std::move(acc0), first[i]);
+            acc1 = op(std::move(acc1), first[lane_size + i]);
+            acc2 = op(std::move(acc2), first[2 * lane_size + i]);
+            acc3 = op(std::move(acc3), first[3 * lane_size + i]);
+        }
+
+        T result = op(op(std::move(acc0), std::move(acc1)), op(std::move(acc2), std::move(acc3)));
+
+        for (size_t i = lanes * lane_size; i < size; ++i)
+            result = op(std::move(result), first[i]);
+
+        return result;
+    }
+}
+
+namespace Details
+{
+    template <typename TContainer>
+    using EnableIfRandomAccess = std::enable_if_t<
+        std::is_base_of_v<std::random_access_iterator_tag,
+            typename std::iterator_traits<decltype(std::begin(std::declval<const TContainer&>()))>::iterator_category>>;
+
+    // op(init, item) must be valid - parallel_reduce(data, op, min_chunk_size) is not taken for (data, init, op)
+    template <typename TContainer, typename T, typename TOp>
+    using EnableIfReducible = std::enable_if_t<std::is_invocable_v<TOp&, T, decltype(*std::begin(std::declval<const TContainer&>()))>,
+        EnableIfRandomAccess<TContainer>>;
+
+    template <typename TIterator, typename T, typename TOp>
+    T parallel_reduce(TIterator first, size_t size, T init, TOp op, size_t min_chunk_size)
+    {
+        if (size == 0)
+            return init;
+
+        const size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+        const size_t chunk_count = std::clamp<size_t>(size / std::max<size_t>(min_chunk_size, 1), 1, hardware_threads);
+        const size_t chunk_size = size / chunk_count;
+
+        std::vector<std::future<T>> partial_results;
+        partial_results.reserve(chunk_count - 1);
+
+        for (size_t i = 0; i < chunk_count - 1; ++i)
+        {
+            partial_results.push_back(std::async(std::launch::async, [=] {
+                return reduce_non_empty<T>(first + i * chunk_size, chunk_size, op);
+            }));
+        }
+
+        const size_t last_chunk_start = (chunk_count - 1) * chunk_size;
+        T last_result = reduce_non_empty<T>(first + last_chunk_start, size - last_chunk_start, op);
+
+        T result = std::move(init);
+        for (auto& partial_result : partial_results)
+            result = op(std::move(result), partial_result.get());
+
+        return op(std::move(result), std::move(last_result));
+    }
+}
+
+// op must be associative - chunks are reduced in separate threads and combined in order
+template <typename TContainer, typename T, typename TOp, typename = Details::EnableIfReducible<TContainer, T, TOp>>
+T parallel_reduce(const TContainer& data, T init, TOp op, size_t min_chunk_size = 100'000)
+{
+    return Details::parallel_reduce(std::begin(data), std::size(data), std::move(init), op, min_chunk_size);
+}
+
+// the first item is the initial value (no identity element of op is needed) - std::nullopt for an empty range
+template <typename TContainer, typename TOp, typename = Details::EnableIfRandomAccess<TContainer>>
+auto parallel_reduce(const TContainer& data, TOp op, size_t min_chunk_size = 100'000)
+{
+    using T = std::decay_t<decltype(*std::begin(data))>;
+
+    const size_t size = std::size(data);
+
+    if (size == 0)
+        return std::optional<T>{};
+
+    auto first = std::begin(data);
+
+    return std::optional<T>{Details::parallel_reduce(first + 1, size - 1, T(*first), op, min_chunk_size)};
+}
+
+TEST_CASE("tree_fold")
+{
+    static_assert(tree_fold(std::plus{}, 1, 2, 3, 4, 5) == 15);
+    static_assert(tree_fold(std::multiplies{}, 42) == 42);
+
+    SECTION("non-commutative op")
+    {
+        REQUIRE(tree_fold(std::plus{}, "a"s, "b"s, "c"s, "d"s, "e"s) == "abcde");
+
+        auto parenthesize = [](const std::string& a, const std::string& b) { return "(" + a + b + ")"; };
+        REQUIRE(tree_fold(parenthesize, "1"s, "2"s, "3"s, "4"s) == "((12)(34))");
+        REQUIRE(tree_fold(parenthesize, "1"s, "2"s, "3"s) == "(1(23))");
+    }
+}
+
+TEST_CASE("parallel_reduce")
+{
+    vector<int> data(1'000'001);
+    std::iota(begin(data), end(data), 0);
+
+    REQUIRE(parallel_reduce(data, 0LL, std::plus{}, 1000) == std::accumulate(begin(data), end(data), 0LL));
+    REQUIRE(parallel_reduce(vector<int>{}, 42, std::plus{}) == 42);
+    REQUIRE(parallel_reduce(vector<int>{1, 2, 3}, std::plus{}) == 6);
+
+    SECTION("without initial value - reduction starts from the first item")
+    {
+        REQUIRE(parallel_reduce(vector<int>{1, 2, 3, 4}, std::multiplies{}) == 24);
+        REQUIRE(parallel_reduce(vector<int>{7}, std::multiplies{}) == 7);
+        REQUIRE(parallel_reduce(vector<int>{}, std::multiplies{}) == std::nullopt);
+
+        vector<double> factors(100'000, 1.0);
+        factors[12'345] = 3.0;
+        factors[87'654] = 0.5;
+        REQUIRE(parallel_reduce(factors, std::multiplies{}, 1000) == 1.5);
+
+        auto max = [](int a, int b) { return std::max(a, b); };
+        auto min = [](int a, int b) { return std::min(a, b); };
+
+        vector<int> negatives(10'000);
+        std::iota(begin(negatives), end(negatives), -20'000);
+        REQUIRE(parallel_reduce(negatives, max, 100) == -10'001);
+        REQUIRE(parallel_reduce(data, min, 1000) == 0);
+        REQUIRE(parallel_reduce(vector<int>{5, 9, 3}, min) == 3);
+    }
+
+    SECTION("non-commutative op")
+    {
+        vector<string> letters;
+        for (int i = 0; i < 10'000; ++i)
+            letters.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+
+        const auto expected = std::accumulate(begin(letters), end(letters), ">"s);
+
+        REQUIRE(parallel_reduce(letters, ">"s, std::plus{}, 16) == expected);
+        REQUIRE(parallel_reduce(vector<string>(begin(letters), begin(letters) + 7), ">"s, std::plus{}) == expected.substr(0, 8));
+    }
+}
+
+TEST_CASE("parallel_reduce - benchmark", "[.][benchmark]")
+{
+    vector<double> data(50'000'000);
+    std::iota(begin(data), end(data), 0.0);
+
+    BENCHMARK("std::accumulate")
+    {
+        return std::accumulate(begin(data), end(data), 0.0);
+    };
+
+    BENCHMARK("single thread, 4 accumulators")
+    {
+        return Details::reduce_non_empty<double>(begin(data), data.size(), std::plus{});
+    };
+
+    BENCHMARK("parallel_reduce")
+    {
+        return parallel_reduce(data, 0.0, std::plus{});
+    };
+}
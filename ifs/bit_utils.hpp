@@ -0,0 +1,239 @@
+#ifndef BIT_UTILS_HPP
+#define BIT_UTILS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bit_cast)
+#define BIT_UTILS_CONSTEXPR_BIT_CAST 1
+#endif
+#endif
+
+namespace Bits
+{
+    // std::bit_cast is C++20 - the builtin (GCC 11+, Clang) makes it usable in constant expressions
+#ifdef BIT_UTILS_CONSTEXPR_BIT_CAST
+    template <typename To, typename From>
+    constexpr To bit_cast(const From& from) noexcept
+    {
+        static_assert(sizeof(To) == sizeof(From));
+        return __builtin_bit_cast(To, from);
+    }
+#else
+    template <typename To, typename From>
+    inline To bit_cast(const From& from) noexcept
+    {
+        static_assert(sizeof(To) == sizeof(From));
+        To to;
+        std::memcpy(&to, &from, sizeof(To));
+        return to;
+    }
+#endif
+
+    template <typename T>
+    constexpr bool is_unsigned_integer_v = std::is_integral_v<T> && std::is_unsigned_v<T> && !std::is_same_v<T, bool>;
+
+    template <typename T>
+    constexpr int popcount(T value) noexcept
+    {
+        static_assert(is_unsigned_integer_v<T>);
+
+#if defined(__GNUC__)
+        if constexpr (sizeof(T) <= sizeof(unsigned))
+            return __builtin_popcount(value);
+        else
+            return __builtin_popcountll(value);
+#else
+        int count = 0;
+        for (; value != 0; value &= value - 1)
+            ++count;
+        return count;
+#endif
+    }
+
+    // number of leading zero bits; digits of T for zero
+    template <typename T>
+    constexpr int countl_zero(T value) noexcept
+    {
+        static_assert(is_unsigned_integer_v<T>);
+
+        constexpr int digits = std::numeric_limits<T>::digits;
+
+        if (value == 0)
+            return digits;
+
+#if defined(__GNUC__)
+        if constexpr (sizeof(T) <= sizeof(unsigned))
+            return __builtin_clz(value) - (std::numeric_limits<unsigned>::digits - digits);
+        else
+            return __builtin_clzll(value) - (std::numeric_limits<unsigned long long>::digits - digits);
+#else
+        int count = 0;
+        for (auto mask = static_cast<T>(T{1} << (digits - 1)); (value & mask) == 0; mask >>= 1)
+            ++count;
+        return count;
+#endif
+    }
+
+    // number of trailing zero bits; digits of T for zero
+    template <typename T>
+    constexpr int countr_zero(T value) noexcept
+    {
+        static_assert(is_unsigned_integer_v<T>);
+
+        if (value == 0)
+            return std::numeric_limits<T>::digits;
+
+#if defined(__GNUC__)
+        if constexpr (sizeof(T) <= sizeof(unsigned))
+            return __builtin_ctz(value);
+        else
+            return __builtin_ctzll(value);
+#else
+        int count = 0;
+        for (; (value & 1) == 0; value >>= 1)
+            ++count;
+        return count;
+#endif
+    }
+
+    // smallest power of 2 not less than value; 1 for 0, 0 when the result does not fit in T
+    template <typename T>
+    constexpr T next_pow2(T value) noexcept
+    {
+        static_assert(is_unsigned_integer_v<T>);
+
+        if (value <= 1)
+            return 1;
+
+        const int width = std::numeric_limits<T>::digits - countl_zero(static_cast<T>(value - 1));
+        if (width == std::numeric_limits<T>::digits)
+            return 0;
+
+        return static_cast<T>(T{1} << width);
+    }
+
+    namespace Details
+    {
+        template <typename T>
+        struct FloatLayout;
+
+        template <>
+        struct FloatLayout<float>
+        {
+            using Bits = uint32_t;
+            static constexpr int mantissa_bits = 23;
+            static constexpr Bits exponent_mask = 0xFF;
+        };
+
+        template <>
+        struct FloatLayout<double>
+        {
+            using Bits = uint64_t;
+            static constexpr int mantissa_bits = 52;
+            static constexpr Bits exponent_mask = 0x7FF;
+        };
+
+        template <typename T, typename = void>
+        constexpr bool has_float_layout_v = false;
+
+        template <typename T>
+        constexpr bool has_float_layout_v<T, std::void_t<typename FloatLayout<T>::Bits>> = std::numeric_limits<T>::is_iec559;
+
+        // positive and either normal with an empty mantissa or subnormal with a single mantissa bit
+        // (same results as frexp(value) == 0.5); no branches, so loops over arrays vectorize
+        template <typename T>
+        constexpr bool is_pow2_float(T value) noexcept
+        {
+            using Layout = FloatLayout<T>;
+            using UInt = typename Layout::Bits;
+
+            constexpr UInt mantissa_mask = (UInt{1} << Layout::mantissa_bits) - 1;
+            constexpr int sign_shift = std::numeric_limits<UInt>::digits - 1;
+
+            const UInt bits = bit_cast<UInt>(value);
+            const UInt exponent = (bits >> Layout::mantissa_bits) & Layout::exponent_mask;
+            const UInt mantissa = bits & mantissa_mask;
+
+            const bool positive = (bits >> sign_shift) == 0;
+            const bool normal = static_cast<UInt>(exponent - 1) < Layout::exponent_mask - 1; // neither zero/subnormal nor inf/NaN
+            const bool single_bit = (mantissa & (mantissa - 1)) == 0;
+
+            return positive & single_bit & ((normal & (mantissa == 0)) | ((exponent == 0) & (mantissa != 0)));
+        }
+    }
+
+    // dispatched on the type: unsigned and signed integers, floats via exponent/mantissa bits
+    // (other floating point formats - e.g. x87 long double - fall back to frexp)
+    template <typename T>
+    constexpr bool is_pow2(T value) noexcept
+    {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+
+        if constexpr (std::is_integral_v<T>)
+        {
+            // x ^ (x - 1) sets the lowest set bit and all bits below it - it exceeds x - 1 only for a single bit
+            // (and wraps to false for zero) - one comparison instead of two
+            using UInt = std::make_unsigned_t<T>;
+            const auto bits = static_cast<UInt>(value);
+            const bool single_bit = static_cast<UInt>(bits ^ (bits - 1)) > static_cast<UInt>(bits - 1);
+
+            if constexpr (std::is_signed_v<T>)
+                return (value > 0) & single_bit;
+            else
+                return single_bit;
+        }
+        else if constexpr (Details::has_float_layout_v<T>)
+        {
+            return Details::is_pow2_float(value);
+        }
+        else
+        {
+            int exponent;
+            return std::frexp(value, &exponent) == static_cast<T>(0.5);
+        }
+    }
+
+    ////////////////////////////////////
+    // batch versions - branch-free loop bodies the compiler can vectorize
+
+    template <typename T>
+    constexpr void is_pow2(const T* values, size_t count, bool* results) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
+            results[i] = is_pow2(values[i]);
+    }
+
+    template <typename T>
+    constexpr size_t count_pow2(const T* values, size_t count) noexcept
+    {
+        size_t result = 0;
+        for (size_t i = 0; i < count; ++i)
+            result += is_pow2(values[i]);
+        return result;
+    }
+
+    // total number of set bits
+    template <typename T>
+    constexpr size_t popcount(const T* values, size_t count) noexcept
+    {
+        size_t result = 0;
+        for (size_t i = 0; i < count; ++i)
+            result += static_cast<size_t>(popcount(values[i]));
+        return result;
+    }
+
+    template <typename T>
+    constexpr void next_pow2(const T* values, size_t count, T* results) noexcept
+    {
+        for (size_t i = 0; i < count; ++i)
+            results[i] = next_pow2(values[i]);
+    }
+}
+
+#endif // BIT_UTILS_HPP
@@ -4,11 +4,14 @@
 #include <mutex>
 #include <numeric>
 #include <queue>
+#include <random>
 #include <string>
 #include <thread>
 #include <vector>
 
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include "catch.hpp"
+#include "bit_utils.hpp"
 
 using namespace std;
 
@@ -116,6 +119,94 @@ TEST_CASE("if constexpr")
     REQUIRE(is_power_of_2(64.0f));
 }
 
+TEST_CASE("bit utilities")
+{
+    static_assert(Bits::popcount(0b1011u) == 3);
+    static_assert(Bits::countl_zero(uint8_t{1}) == 7);
+    static_assert(Bits::countl_zero(uint64_t{0}) == 64);
+    static_assert(Bits::countr_zero(uint16_t{8}) == 3);
+    static_assert(Bits::next_pow2(5u) == 8);
+    static_assert(Bits::next_pow2(uint8_t{128}) == 128);
+    static_assert(Bits::next_pow2(uint8_t{129}) == 0);
+
+    static_assert(Bits::is_pow2(64));
+    static_assert(!Bits::is_pow2(-64));
+#ifdef BIT_UTILS_CONSTEXPR_BIT_CAST
+    static_assert(Bits::is_pow2(0.125));
+    static_assert(!Bits::is_pow2(3.0f));
+#endif
+
+    SECTION("same results as the frexp version")
+    {
+        const double special[] = {0.0, -0.0, 1.0, 0.5, -2.0, 3.0, 1e300, std::numeric_limits<double>::denorm_min(),
+            3 * std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::min(),
+            std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN(), std::ldexp(1.0, 1023)};
+
+        for (double value : special)
+        {
+            INFO(value);
+            REQUIRE(Bits::is_pow2(value) == Cpp17::is_power_of_2(value));
+            REQUIRE(Bits::is_pow2(static_cast<float>(value)) == Cpp17::is_power_of_2(static_cast<float>(value)));
+        }
+
+        for (int exponent = -1074; exponent <= 1023; ++exponent)
+            REQUIRE(Bits::is_pow2(std::ldexp(1.0, exponent)));
+
+        for (long double value : {0.25L, 3.0L})
+            REQUIRE(Bits::is_pow2(value) == Cpp17::is_power_of_2(value));
+    }
+
+    SECTION("batch versions")
+    {
+        const uint32_t values[] = {0, 1, 3, 4, 1000, 1u << 31};
+
+        bool results[std::size(values)];
+        Bits::is_pow2(values, std::size(values), results);
+        REQUIRE(std::vector(std::begin(results), std::end(results)) == std::vector{false, true, false, true, false, true});
+
+        REQUIRE(Bits::count_pow2(values, std::size(values)) == 3);
+        REQUIRE(Bits::popcount(values, std::size(values)) == 0 + 1 + 2 + 1 + 6 + 1);
+
+        uint32_t next[std::size(values)];
+        Bits::next_pow2(values, std::size(values), next);
+        REQUIRE(std::vector(std::begin(next), std::end(next)) == std::vector<uint32_t>{1, 1, 4, 4, 1024, 1u << 31});
+    }
+}
+
+TEST_CASE("is_power_of_2 - benchmark", "[.][benchmark]")
+{
+    constexpr size_t count = 1'000'000;
+
+    std::mt19937_64 rnd{665};
+    std::vector<double> doubles(count);
+    std::vector<uint64_t> integers(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        integers[i] = rnd() % 4 == 0 ? uint64_t{1} << (rnd() % 64) : rnd();
+        doubles[i] = rnd() % 4 == 0 ? std::ldexp(1.0, static_cast<int>(rnd() % 200) - 100) : static_cast<double>(rnd()) / 7;
+    }
+
+    BENCHMARK("double - frexp")
+    {
+        return std::count_if(doubles.begin(), doubles.end(), [](double x) { return Cpp17::is_power_of_2(x); });
+    };
+
+    BENCHMARK("double - Bits::count_pow2")
+    {
+        return Bits::count_pow2(doubles.data(), doubles.size());
+    };
+
+    BENCHMARK("uint64_t - Cpp17::is_power_of_2")
+    {
+        return std::count_if(integers.begin(), integers.end(), [](uint64_t x) { return Cpp17::is_power_of_2(x); });
+    };
+
+    BENCHMARK("uint64_t - Bits::count_pow2")
+    {
+        return Bits::count_pow2(integers.data(), integers.size());
+    };
+}
+
 namespace BeforeCpp17
 {
     void print()
@@ -0,0 +1,196 @@
+#ifndef BULK_PARSE_HPP
+#define BULK_PARSE_HPP
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+struct BulkParseResult
+{
+    size_t count;                         // numbers written to the output
+    size_t end_position;                  // offset in the text where parsing stopped
+    std::optional<size_t> error_position; // offset of the first malformed token
+};
+
+namespace BulkParseDetails
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    constexpr bool swar_enabled = true;
+#else
+    constexpr bool swar_enabled = false;
+#endif
+
+    inline uint64_t load_8_bytes(const char* text) noexcept
+    {
+        uint64_t chunk;
+        std::memcpy(&chunk, text, sizeof(chunk));
+        return chunk;
+    }
+
+    // SWAR - a byte is a digit when its high nibble is 3 and adding 6 does not carry into the high nibble;
+    // returns 0x80 in every byte that is not a digit (carries may corrupt only bytes after the first non-digit)
+    constexpr uint64_t non_digit_mask(uint64_t chunk) noexcept
+    {
+        const uint64_t difference = ((chunk & 0xF0F0F0F0F0F0F0F0) ^ 0x3030303030303030)
+                                    | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) ^ 0x3030303030303030);
+
+        return (((difference & 0x7F7F7F7F7F7F7F7F) + 0x7F7F7F7F7F7F7F7F) | difference) & 0x8080808080808080;
+    }
+
+    inline unsigned count_trailing_zeros(uint64_t value) noexcept
+    {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+        unsigned count = 0;
+        for (; (value & 1) == 0; value >>= 1)
+            ++count;
+        return count;
+#endif
+    }
+
+    // SWAR - digits are combined pairwise: 8 x 1 digit -> 4 x 2 digits -> 2 x 4 digits -> 8 digits
+    constexpr uint32_t parse_8_digits(uint64_t chunk) noexcept
+    {
+        constexpr uint64_t mask = 0x000000FF000000FF;
+        constexpr uint64_t multiplier_1 = 100 + (1000000ULL << 32);
+        constexpr uint64_t multiplier_2 = 1 + (10000ULL << 32);
+
+        chunk -= 0x3030303030303030;
+        chunk = (chunk * 10) + (chunk >> 8);
+        chunk = (((chunk & mask) * multiplier_1) + (((chunk >> 16) & mask) * multiplier_2)) >> 32;
+
+        return static_cast<uint32_t>(chunk);
+    }
+
+    constexpr uint64_t powers_of_10[] = {1, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000};
+
+    constexpr bool is_digit(char c) noexcept
+    {
+        return static_cast<unsigned char>(c - '0') < 10;
+    }
+
+    // on success returns the end of the number; nullptr when the token is not a valid T
+    template <typename T>
+    const char* parse_integer(const char* first, const char* last, T& value) noexcept
+    {
+        const char* pos = first;
+
+        const bool negative = std::is_signed_v<T> && pos != last && *pos == '-';
+        if (negative)
+            ++pos;
+
+        const char* digits_begin = pos;
+        uint64_t magnitude = 0;
+
+        bool scalar_tail = true;
+
+        if constexpr (swar_enabled)
+        {
+            while (last - pos >= 8)
+            {
+                const uint64_t chunk = load_8_bytes(pos);
+                const uint64_t non_digits = non_digit_mask(chunk);
+
+                if (non_digits == 0)
+                {
+                    magnitude = magnitude * 100'000'000 + parse_8_digits(chunk);
+                    pos += 8;
+                    continue;
+                }
+
+                // fewer than 8 digits - they are moved to the top bytes and padded with leading '0's
+                if (const unsigned digits = count_trailing_zeros(non_digits) / 8; digits > 0)
+                {
+                    const uint64_t padded = (chunk << (8 * (8 - digits))) | (0x3030303030303030 >> (8 * digits));
+                    magnitude = magnitude * powers_of_10[digits] + parse_8_digits(padded);
+                    pos += digits;
+                }
+
+                scalar_tail = false;
+                break;
+            }
+        }
+
+        if (scalar_tail)
+            while (pos != last && is_digit(*pos))
+                magnitude = magnitude * 10 + static_cast<unsigned>(*pos++ - '0');
+
+        const auto digit_count = pos - digits_begin;
+        if (digit_count == 0)
+            return nullptr;
+
+        // magnitude may have wrapped - let from_chars decide about (rare) long numbers
+        if (digit_count > std::numeric_limits<uint64_t>::digits10)
+        {
+            const auto [end, error] = std::from_chars(first, pos, value);
+            return (error == std::errc{} && end == pos) ? pos : nullptr;
+        }
+
+        using UnsignedT = std::make_unsigned_t<T>;
+        constexpr uint64_t max_positive = std::numeric_limits<T>::max();
+        constexpr uint64_t max_negative = max_positive + (std::is_signed_v<T> ? 1 : 0);
+
+        if (magnitude > (negative ? max_negative : max_positive))
+            return nullptr;
+
+        value = negative ? static_cast<T>(UnsignedT{0} - static_cast<UnsignedT>(magnitude)) : static_cast<T>(magnitude);
+
+        return pos;
+    }
+
+    template <typename T>
+    const char* parse_number(const char* first, const char* last, T& value) noexcept
+    {
+        if constexpr (std::is_integral_v<T>)
+        {
+            return parse_integer(first, last, value);
+        }
+        else
+        {
+            const auto [end, error] = std::from_chars(first, last, value);
+            return error == std::errc{} ? end : nullptr;
+        }
+    }
+}
+
+// parses numbers separated by delimiter (a trailing delimiter is allowed) into output[0..capacity) -
+// stops at the first malformed token or when the output is full; nothing is allocated
+// integers - 8 digits at a time with SWAR; floating point - std::from_chars
+template <typename T>
+BulkParseResult parse_numbers(std::string_view text, char delimiter, T* output, size_t capacity) noexcept
+{
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+
+    const char* const begin = text.data();
+    const char* const end = begin + text.size();
+
+    const char* pos = begin;
+    size_t count = 0;
+
+    while (pos != end && count != capacity)
+    {
+        const char* token_end = BulkParseDetails::parse_number(pos, end, output[count]);
+
+        if (token_end == nullptr || (token_end != end && *token_end != delimiter))
+            return {count, static_cast<size_t>(pos - begin), static_cast<size_t>(pos - begin)};
+
+        ++count;
+        pos = (token_end == end) ? end : token_end + 1;
+    }
+
+    return {count, static_cast<size_t>(pos - begin), std::nullopt};
+}
+
+template <typename T, size_t N>
+BulkParseResult parse_numbers(std::string_view text, char delimiter, T (&output)[N]) noexcept
+{
+    return parse_numbers(text, delimiter, output, N);
+}
+
+#endif // BULK_PARSE_HPP
@@ -0,0 +1,548 @@
+#ifndef COMPACT_OPTIONAL_HPP
+#define COMPACT_OPTIONAL_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "validity_bitmap.hpp"
+
+// a policy tells how "empty" is encoded in the storage:
+//   storage_type, empty_value(), is_empty(storage), store(value), load(storage)
+
+// one reserved value of T means "empty" - INT_MIN, nullptr, a spare enumerator...
+template <typename T, T Sentinel>
+struct SentinelValue
+{
+    using storage_type = T;
+
+    static constexpr T empty_value() noexcept
+    {
+        return Sentinel;
+    }
+
+    static constexpr bool is_empty(const T& value) noexcept
+    {
+        return value == Sentinel;
+    }
+
+    static constexpr const T& store(const T& value) noexcept
+    {
+        return value;
+    }
+
+    static constexpr const T& load(const T& value) noexcept
+    {
+        return value;
+    }
+};
+
+// floating point values cannot be template arguments in C++17 - every NaN means "empty"
+template <typename T>
+struct NaNSentinel
+{
+    static_assert(std::numeric_limits<T>::has_quiet_NaN);
+
+    using storage_type = T;
+
+    static constexpr T empty_value() noexcept
+    {
+        return std::numeric_limits<T>::quiet_NaN();
+    }
+
+    static constexpr bool is_empty(const T& value) noexcept
+    {
+        return value != value;
+    }
+
+    static constexpr const T& store(const T& value) noexcept
+    {
+        return value;
+    }
+
+    static constexpr const T& load(const T& value) noexcept
+    {
+        return value;
+    }
+};
+
+// bool has no spare value - it is kept in a byte where 2 means "empty"
+struct BoolSentinel
+{
+    using storage_type = uint8_t;
+
+    static constexpr uint8_t empty_value() noexcept
+    {
+        return 2;
+    }
+
+    static constexpr bool is_empty(uint8_t value) noexcept
+    {
+        return value == 2;
+    }
+
+    static constexpr uint8_t store(bool value) noexcept
+    {
+        return value;
+    }
+
+    static constexpr bool load(uint8_t value) noexcept
+    {
+        return value != 0;
+    }
+};
+
+namespace CompactOptionalDetails
+{
+    template <typename T>
+    auto default_sentinel()
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return BoolSentinel{};
+        else if constexpr (std::is_floating_point_v<T>)
+            return NaNSentinel<T>{};
+        else if constexpr (std::is_pointer_v<T>)
+            return SentinelValue<T, nullptr>{};
+        else if constexpr (std::is_signed_v<T>)
+            return SentinelValue<T, std::numeric_limits<T>::min()>{};
+        else if constexpr (std::is_unsigned_v<T>)
+            return SentinelValue<T, std::numeric_limits<T>::max()>{};
+        else
+            static_assert(std::is_arithmetic_v<T>, "no default sentinel - pass a policy explicitly");
+    }
+}
+
+// signed - min(), unsigned - max(), floating point - NaN, pointers - nullptr, bool - a spare byte value
+template <typename T>
+using DefaultSentinel = decltype(CompactOptionalDetails::default_sentinel<T>());
+
+// std::optional interface with sizeof(CompactOptional<T>) == sizeof(T) - no engaged flag, no padding;
+// storing the sentinel itself as a value is a precondition violation
+// (for policies storing T directly operator* returns a reference, otherwise a value)
+template <typename T, typename Policy = DefaultSentinel<T>>
+class CompactOptional
+{
+    using Storage = typename Policy::storage_type;
+
+    static constexpr bool stores_value = std::is_same_v<Storage, T>;
+
+    Storage storage_ = Policy::empty_value();
+
+    static constexpr Storage checked_store(const T& value) noexcept
+    {
+        assert(!Policy::is_empty(Policy::store(value)) && "sentinel value cannot be stored");
+        return Policy::store(value);
+    }
+
+public:
+    using value_type = T;
+    using policy_type = Policy;
+
+    constexpr CompactOptional() noexcept = default;
+
+    constexpr CompactOptional(std::nullopt_t) noexcept
+    {
+    }
+
+    constexpr CompactOptional(const T& value) noexcept
+        : storage_{checked_store(value)}
+    {
+    }
+
+    constexpr CompactOptional& operator=(std::nullopt_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    constexpr CompactOptional& operator=(const T& value) noexcept
+    {
+        storage_ = checked_store(value);
+        return *this;
+    }
+
+    constexpr bool has_value() const noexcept
+    {
+        return !Policy::is_empty(storage_);
+    }
+
+    constexpr explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    constexpr decltype(auto) operator*() const noexcept
+    {
+        return Policy::load(storage_);
+    }
+
+    template <bool Enabled = stores_value, typename = std::enable_if_t<Enabled>>
+    constexpr T& operator*() noexcept
+    {
+        return storage_;
+    }
+
+    template <bool Enabled = stores_value, typename = std::enable_if_t<Enabled>>
+    constexpr const T* operator->() const noexcept
+    {
+        return &storage_;
+    }
+
+    constexpr decltype(auto) value() const
+    {
+        if (!has_value())
+            throw std::bad_optional_access{};
+
+        return **this;
+    }
+
+    template <typename U>
+    constexpr T value_or(U&& default_value) const
+    {
+        return has_value() ? T(Policy::load(storage_)) : static_cast<T>(std::forward<U>(default_value));
+    }
+
+    template <typename... TArgs>
+    constexpr decltype(auto) emplace(TArgs&&... args)
+    {
+        storage_ = checked_store(T(std::forward<TArgs>(args)...));
+        return **this;
+    }
+
+    constexpr void reset() noexcept
+    {
+        storage_ = Policy::empty_value();
+    }
+
+    constexpr void swap(CompactOptional& other) noexcept
+    {
+        std::swap(storage_, other.storage_);
+    }
+
+    std::optional<T> to_optional() const
+    {
+        return has_value() ? std::optional<T>{**this} : std::nullopt;
+    }
+
+    // comparisons of two CompactOptionals follow std::optional - empty is less than any value
+    // (with std::nullopt and T only == and != are provided)
+    friend constexpr bool operator==(const CompactOptional& lhs, const CompactOptional& rhs)
+    {
+        return lhs.has_value() == rhs.has_value() && (!lhs.has_value() || *lhs == *rhs);
+    }
+
+    friend constexpr bool operator!=(const CompactOptional& lhs, const CompactOptional& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(const CompactOptional& lhs, const CompactOptional& rhs)
+    {
+        return rhs.has_value() && (!lhs.has_value() || *lhs < *rhs);
+    }
+
+    friend constexpr bool operator>(const CompactOptional& lhs, const CompactOptional& rhs)
+    {
+        return rhs < lhs;
+    }
+
+    friend constexpr bool operator<=(const CompactOptional& lhs, const CompactOptional& rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    friend constexpr bool operator>=(const CompactOptional& lhs, const CompactOptional& rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    friend constexpr bool operator==(const CompactOptional& opt, std::nullopt_t) noexcept
+    {
+        return !opt.has_value();
+    }
+
+    friend constexpr bool operator==(std::nullopt_t, const CompactOptional& opt) noexcept
+    {
+        return !opt.has_value();
+    }
+
+    friend constexpr bool operator!=(const CompactOptional& opt, std::nullopt_t) noexcept
+    {
+        return opt.has_value();
+    }
+
+    friend constexpr bool operator!=(std::nullopt_t, const CompactOptional& opt) noexcept
+    {
+        return opt.has_value();
+    }
+
+    friend constexpr bool operator==(const CompactOptional& opt, const T& value)
+    {
+        return opt.has_value() && *opt == value;
+    }
+
+    friend constexpr bool operator==(const T& value, const CompactOptional& opt)
+    {
+        return opt == value;
+    }
+
+    friend constexpr bool operator!=(const CompactOptional& opt, const T& value)
+    {
+        return !(opt == value);
+    }
+
+    friend constexpr bool operator!=(const T& value, const CompactOptional& opt)
+    {
+        return !(opt == value);
+    }
+};
+
+// column of optional values - values are stored contiguously, presence as a bitmap
+// (n * sizeof(T) + n / 8 bytes instead of n * sizeof(std::optional<T>))
+template <typename T>
+class OptionalArray
+{
+    std::vector<T> values_;
+    ValidityBitmap present_;
+
+public:
+    using value_type = std::optional<T>;
+
+    // proxy returned by the non-const operator[] (like std::vector<bool>::reference)
+    class Reference
+    {
+        OptionalArray& array_;
+        size_t index_;
+
+    public:
+        Reference(OptionalArray& array, size_t index) noexcept
+            : array_{array}, index_{index}
+        {
+        }
+
+        Reference(const Reference&) = default;
+
+        // assigns the referenced item (arr[i] = arr[j]), not the reference - as std::vector<bool>::reference
+        Reference& operator=(const Reference& other)
+        {
+            return *this = std::optional<T>(other);
+        }
+
+        Reference& operator=(const T& value)
+        {
+            array_.set(index_, value);
+            return *this;
+        }
+
+        Reference& operator=(std::nullopt_t)
+        {
+            array_.reset(index_);
+            return *this;
+        }
+
+        Reference& operator=(const std::optional<T>& item)
+        {
+            if (item)
+                array_.set(index_, *item);
+            else
+                array_.reset(index_);
+            return *this;
+        }
+
+        operator std::optional<T>() const
+        {
+            return std::as_const(array_)[index_];
+        }
+
+        bool has_value() const noexcept
+        {
+            return array_.has_value(index_);
+        }
+
+        template <typename U>
+        T value_or(U&& default_value) const
+        {
+            return array_.value_or(index_, std::forward<U>(default_value));
+        }
+
+        friend bool operator==(const Reference& ref, const std::optional<T>& item)
+        {
+            return std::optional<T>(ref) == item;
+        }
+
+        friend bool operator!=(const Reference& ref, const std::optional<T>& item)
+        {
+            return !(ref == item);
+        }
+    };
+
+    // yields std::optional<T> by value
+    class ConstIterator
+    {
+        const OptionalArray* array_;
+        size_t index_;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::optional<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::optional<T>;
+
+        ConstIterator(const OptionalArray* array, size_t index) noexcept
+            : array_{array}, index_{index}
+        {
+        }
+
+        std::optional<T> operator*() const
+        {
+            return (*array_)[index_];
+        }
+
+        ConstIterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        ConstIterator operator++(int) noexcept
+        {
+            ConstIterator temp = *this;
+            ++index_;
+            return temp;
+        }
+
+        bool operator==(const ConstIterator& other) const noexcept
+        {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const ConstIterator& other) const noexcept
+        {
+            return index_ != other.index_;
+        }
+    };
+
+    using const_iterator = ConstIterator;
+
+    OptionalArray() = default;
+
+    OptionalArray(std::initializer_list<std::optional<T>> items)
+    {
+        reserve(items.size());
+        for (const auto& item : items)
+            push_back(item);
+    }
+
+    size_t size() const noexcept
+    {
+        return values_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return values_.empty();
+    }
+
+    void reserve(size_t capacity)
+    {
+        values_.reserve(capacity);
+        present_.reserve(capacity);
+    }
+
+    void push_back(const T& value)
+    {
+        values_.push_back(value);
+        present_.push_back(true);
+    }
+
+    void push_back(std::nullopt_t)
+    {
+        values_.emplace_back();
+        present_.push_back(false);
+    }
+
+    void push_back(const std::optional<T>& item)
+    {
+        if (item)
+            push_back(*item);
+        else
+            push_back(std::nullopt);
+    }
+
+    bool has_value(size_t index) const noexcept
+    {
+        return present_.test(index);
+    }
+
+    std::optional<T> operator[](size_t index) const
+    {
+        return has_value(index) ? std::optional<T>{values_[index]} : std::nullopt;
+    }
+
+    Reference operator[](size_t index) noexcept
+    {
+        return Reference{*this, index};
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator{this, 0};
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator{this, size()};
+    }
+
+    const T& value(size_t index) const
+    {
+        if (!has_value(index))
+            throw std::bad_optional_access{};
+
+        return values_[index];
+    }
+
+    template <typename U>
+    T value_or(size_t index, U&& default_value) const
+    {
+        return has_value(index) ? values_[index] : static_cast<T>(std::forward<U>(default_value));
+    }
+
+    void set(size_t index, const T& value)
+    {
+        values_[index] = value;
+        present_.set(index);
+    }
+
+    void reset(size_t index)
+    {
+        values_[index] = T{};
+        present_.reset(index);
+    }
+
+    // number of items with a value
+    size_t count() const noexcept
+    {
+        return present_.count();
+    }
+
+    const ValidityBitmap& validity() const noexcept
+    {
+        return present_;
+    }
+
+    // raw values - slots without a value always hold T{}
+    const T* values() const noexcept
+    {
+        return values_.data();
+    }
+};
+
+#endif // COMPACT_OPTIONAL_HPP
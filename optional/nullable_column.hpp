@@ -0,0 +1,140 @@
+#ifndef NULLABLE_COLUMN_HPP
+#define NULLABLE_COLUMN_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "compact_optional.hpp"
+
+// numeric column with a validity bitmap - bulk operations work on blocks of 64 items per bitmap word:
+// a full word is processed as a plain array (vectorizable), an empty word is skipped,
+// only mixed words look at single bits; null slots hold T{}, so they add nothing to sums
+template <typename T>
+class NullableColumn : public OptionalArray<T>
+{
+    static_assert(std::is_arithmetic_v<T>, "NullableColumn supports only arithmetic types");
+
+    using Base = OptionalArray<T>;
+
+    static constexpr size_t block_size = ValidityBitmap::bits_per_word;
+
+    static constexpr uint64_t block_mask(size_t count) noexcept
+    {
+        return count == block_size ? ~uint64_t{0} : (uint64_t{1} << count) - 1;
+    }
+
+    static unsigned lowest_bit(uint64_t word) noexcept
+    {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+        unsigned index = 0;
+        for (; (word & 1) == 0; word >>= 1)
+            ++index;
+        return index;
+#endif
+    }
+
+    // f(validity word, values of the block, block size, index of the first item)
+    template <typename F>
+    void for_each_block(F f) const
+    {
+        const uint64_t* words = this->validity().words();
+        const T* values = this->values();
+        const size_t size = this->size();
+
+        for (size_t first = 0, word = 0; first < size; first += block_size, ++word)
+            f(words[word], values + first, std::min(block_size, size - first), first);
+    }
+
+public:
+    using Base::Base;
+
+    size_t count_present() const noexcept
+    {
+        return this->count();
+    }
+
+    size_t count_null() const noexcept
+    {
+        return this->size() - this->count();
+    }
+
+    // output[i] = value or default_value for null items; output must hold size() items
+    // (value_or(index, default_value) of OptionalArray reads a single item)
+    void fill_value_or(T default_value, T* output) const
+    {
+        for_each_block([&](uint64_t word, const T* values, size_t count, size_t first) {
+            T* out = output + first;
+
+            if (word == 0)
+            {
+                std::fill_n(out, count, default_value);
+                return;
+            }
+
+            std::copy_n(values, count, out);
+
+            for (uint64_t nulls = ~word & block_mask(count); nulls != 0; nulls &= nulls - 1)
+                out[lowest_bit(nulls)] = default_value;
+        });
+    }
+
+    std::vector<T> values_or(T default_value) const
+    {
+        std::vector<T> result(this->size());
+        fill_value_or(default_value, result.data());
+        return result;
+    }
+
+    // null slots are zero - values are summed without looking at the bitmap
+    // (four accumulators - for floating point the result may differ from a sequential sum in the last bits)
+    T sum_present() const noexcept
+    {
+        const T* values = this->values();
+        const size_t size = this->size();
+
+        T lanes[4] = {};
+
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            lanes[0] += values[i];
+            lanes[1] += values[i + 1];
+            lanes[2] += values[i + 2];
+            lanes[3] += values[i + 3];
+        }
+
+        for (; i < size; ++i)
+            lanes[0] += values[i];
+
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+
+    // present items satisfying the predicate
+    template <typename Predicate>
+    NullableColumn filter(Predicate predicate) const
+    {
+        NullableColumn result;
+
+        for_each_block([&](uint64_t word, const T* values, size_t count, size_t) {
+            if (word == block_mask(count))
+            {
+                for (size_t i = 0; i < count; ++i)
+                    if (predicate(values[i]))
+                        result.push_back(values[i]);
+                return;
+            }
+
+            for (; word != 0; word &= word - 1)
+                if (const T& value = values[lowest_bit(word)]; predicate(value))
+                    result.push_back(value);
+        });
+
+        return result;
+    }
+};
+
+#endif // NULLABLE_COLUMN_HPP
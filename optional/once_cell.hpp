@@ -0,0 +1,104 @@
+#ifndef ONCE_CELL_HPP
+#define ONCE_CELL_HPP
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// std::optional with a thread-safe emplace - the value is constructed exactly once, by the first caller;
+// after initialization every access is a single acquire load (no mutex, no read-modify-write)
+// if the initializer throws, the cell stays empty and the next caller tries again
+template <typename T>
+class OnceCell
+{
+    std::atomic<bool> initialized_{false};
+    std::mutex init_mutex_;
+    std::optional<T> value_;
+
+    template <typename F>
+    T& initialize(F&& init)
+    {
+        std::lock_guard lk{init_mutex_};
+
+        if (!initialized_.load(std::memory_order_relaxed))
+        {
+            value_.emplace(std::invoke(std::forward<F>(init)));
+            initialized_.store(true, std::memory_order_release);
+        }
+
+        return *value_;
+    }
+
+public:
+    OnceCell() = default;
+    OnceCell(const OnceCell&) = delete;
+    OnceCell& operator=(const OnceCell&) = delete;
+
+    // init() result is used to construct T (e.g. OnceCell<std::atomic<int>> with init returning int)
+    template <typename F>
+    T& get_or_init(F&& init)
+    {
+        if (initialized_.load(std::memory_order_acquire))
+            return *value_;
+
+        return initialize(std::forward<F>(init));
+    }
+
+    // nullptr until initialized
+    T* get() noexcept
+    {
+        return initialized_.load(std::memory_order_acquire) ? &*value_ : nullptr;
+    }
+
+    const T* get() const noexcept
+    {
+        return initialized_.load(std::memory_order_acquire) ? &*value_ : nullptr;
+    }
+
+    bool is_initialized() const noexcept
+    {
+        return initialized_.load(std::memory_order_acquire);
+    }
+};
+
+// value computed by init() on first access from any thread
+template <typename T, typename F = std::function<T()>>
+class Lazy
+{
+    OnceCell<T> cell_;
+    F init_;
+
+public:
+    explicit Lazy(F init)
+        : init_{std::move(init)}
+    {
+    }
+
+    T& get()
+    {
+        return cell_.get_or_init(init_);
+    }
+
+    T& operator*()
+    {
+        return get();
+    }
+
+    T* operator->()
+    {
+        return &get();
+    }
+
+    bool is_initialized() const noexcept
+    {
+        return cell_.is_initialized();
+    }
+};
+
+template <typename F>
+Lazy(F) -> Lazy<std::decay_t<std::invoke_result_t<F&>>, F>;
+
+#endif // ONCE_CELL_HPP
@@ -7,8 +7,17 @@
 #include <atomic>
 #include <charconv>
 #include <array>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
 
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include "catch.hpp"
+#include "bulk_parse.hpp"
+#include "compact_optional.hpp"
+#include "nullable_column.hpp"
+#include "once_cell.hpp"
 
 using namespace std;
 
@@ -94,6 +103,540 @@ TEST_CASE("to_int")
     REQUIRE(number.has_value() == false);
 }
 
+TEST_CASE("parse_numbers - integers")
+{
+    SECTION("delimited values")
+    {
+        int values[8];
+        const auto result = parse_numbers("42,-7,0,2147483647,-2147483648,", ',', values);
+
+        REQUIRE(result.count == 5);
+        REQUIRE_FALSE(result.error_position.has_value());
+        REQUIRE(vector(values, values + 5) == vector{42, -7, 0, 2147483647, -2147483647 - 1});
+    }
+
+    SECTION("long numbers use 8-digit chunks")
+    {
+        int64_t values[4];
+        const auto result = parse_numbers("1234567890123456789;-9223372036854775808;00000000000000000000042", ';', values);
+
+        REQUIRE(result.count == 3);
+        REQUIRE(values[0] == 1234567890123456789);
+        REQUIRE(values[1] == std::numeric_limits<int64_t>::min());
+        REQUIRE(values[2] == 42);
+    }
+
+    SECTION("position of the first bad token is reported")
+    {
+        int values[8];
+
+        auto result = parse_numbers("1,2,44as,5", ',', values);
+        REQUIRE(result.count == 2);
+        REQUIRE(result.error_position == 4u);
+
+        result = parse_numbers("1,,2", ',', values);
+        REQUIRE(result.error_position == 2u);
+
+        result = parse_numbers("1,3000000000", ',', values); // out of range for int
+        REQUIRE(result.count == 1);
+        REQUIRE(result.error_position == 2u);
+
+        uint32_t unsigned_values[2];
+        result = parse_numbers("-1", ',', unsigned_values);
+        REQUIRE(result.error_position == 0u);
+    }
+
+    SECTION("parsing stops when the output is full")
+    {
+        int values[2];
+        const auto result = parse_numbers("1,2,3", ',', values);
+
+        REQUIRE(result.count == 2);
+        REQUIRE(result.end_position == 4);
+        REQUIRE_FALSE(result.error_position.has_value());
+    }
+
+    SECTION("same results as from_chars")
+    {
+        std::mt19937_64 rnd{665};
+        std::uniform_int_distribution<int64_t> distribution{std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()};
+
+        for (int i = 0; i < 10'000; ++i)
+        {
+            const int64_t expected = distribution(rnd) >> (rnd() % 64);
+            const string text = std::to_string(expected);
+
+            int64_t value;
+            REQUIRE(parse_numbers(text, ',', &value, 1).count == 1);
+            REQUIRE(value == expected);
+        }
+    }
+}
+
+TEST_CASE("parse_numbers - floating point")
+{
+    double values[4];
+    const auto result = parse_numbers("3.14 -1e-3 42 x", ' ', values);
+
+    REQUIRE(result.count == 3);
+    REQUIRE(values[0] == 3.14);
+    REQUIRE(values[1] == -1e-3);
+    REQUIRE(values[2] == 42.0);
+    REQUIRE(result.error_position == 14u);
+}
+
+TEST_CASE("parse_numbers - benchmark", "[.][benchmark]")
+{
+    constexpr size_t count = 1'000'000;
+
+    std::mt19937 rnd{665};
+    std::uniform_int_distribution<int> distribution{std::numeric_limits<int>::min(), std::numeric_limits<int>::max()};
+
+    string text;
+    for (size_t i = 0; i < count; ++i)
+    {
+        text += std::to_string(distribution(rnd));
+        text += ',';
+    }
+
+    std::vector<int> output(count);
+
+    BENCHMARK("to_int per token")
+    {
+        string_view rest = text;
+        size_t parsed = 0;
+
+        while (!rest.empty())
+        {
+            const size_t delimiter = rest.find(',');
+            if (auto value = to_int(rest.substr(0, delimiter)))
+                output[parsed++] = *value;
+            rest.remove_prefix(delimiter == string_view::npos ? rest.size() : delimiter + 1);
+        }
+
+        return parsed;
+    };
+
+    BENCHMARK("parse_numbers<int>")
+    {
+        return parse_numbers(text, ',', output.data(), output.size()).count;
+    };
+}
+
+namespace
+{
+    enum class Color : uint8_t
+    {
+        red,
+        green,
+        blue,
+        unset
+    };
+
+    struct SensorSample
+    {
+        std::optional<int> reading;
+        std::optional<bool> calibrated;
+        std::optional<double> offset;
+    };
+
+    struct CompactSensorSample
+    {
+        CompactOptional<int> reading;
+        CompactOptional<bool> calibrated;
+        CompactOptional<double> offset;
+    };
+}
+
+TEST_CASE("CompactOptional")
+{
+    static_assert(sizeof(CompactOptional<int>) == sizeof(int));
+    static_assert(sizeof(CompactOptional<bool>) == sizeof(bool));
+    static_assert(sizeof(CompactOptional<double>) == sizeof(double));
+    static_assert(sizeof(CompactOptional<const char*>) == sizeof(const char*));
+    static_assert(sizeof(CompactOptional<Color, SentinelValue<Color, Color::unset>>) == 1);
+    static_assert(sizeof(CompactSensorSample) < sizeof(SensorSample));
+
+    SECTION("same interface as std::optional")
+    {
+        CompactOptional<int> o1;
+        REQUIRE(o1.has_value() == false);
+        REQUIRE(o1 == std::nullopt);
+        REQUIRE(o1.value_or(-1) == -1);
+        REQUIRE_THROWS_AS(o1.value(), std::bad_optional_access);
+
+        o1 = 42;
+        REQUIRE(o1);
+        REQUIRE(*o1 == 42);
+        REQUIRE(o1 == 42);
+        REQUIRE(o1 != std::nullopt);
+
+        o1.emplace(665);
+        REQUIRE(o1.value() == 665);
+
+        o1.reset();
+        REQUIRE_FALSE(o1.has_value());
+
+        REQUIRE(CompactOptional<int>{} < CompactOptional<int>{1});
+        REQUIRE(CompactOptional<int>{1} < CompactOptional<int>{2});
+    }
+
+    SECTION("ordering as std::optional")
+    {
+        const CompactOptional<int> empty, one{1}, two{2};
+
+        REQUIRE(two > one);
+        REQUIRE(one > empty);
+        REQUIRE_FALSE(empty > empty);
+        REQUIRE(one <= one);
+        REQUIRE(empty <= one);
+        REQUIRE_FALSE(two <= one);
+        REQUIRE(two >= one);
+        REQUIRE(empty >= empty);
+        REQUIRE_FALSE(empty >= one);
+    }
+
+    SECTION("bool - no surprises with comparisons")
+    {
+        CompactOptional<bool> flag{false};
+
+        REQUIRE(flag.has_value());
+        REQUIRE(flag == false);
+        REQUIRE(flag.value() == false);
+
+        flag = std::nullopt;
+        REQUIRE(flag != false);
+        REQUIRE(flag.to_optional() == std::nullopt);
+    }
+
+    SECTION("NaN means empty for floating point")
+    {
+        CompactOptional<double> offset;
+        REQUIRE_FALSE(offset.has_value());
+
+        offset = 0.5;
+        REQUIRE(offset.value_or(0.0) == 0.5);
+
+        offset.reset();
+        REQUIRE(offset.value_or(0.0) == 0.0);
+    }
+
+    SECTION("spare enumerator as a sentinel")
+    {
+        CompactOptional<Color, SentinelValue<Color, Color::unset>> color;
+        REQUIRE(color == std::nullopt);
+
+        color = Color::green;
+        REQUIRE(color == Color::green);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr CompactOptional<int> empty;
+        constexpr CompactOptional<int> answer = 42;
+
+        static_assert(!empty.has_value());
+        static_assert(answer.value() == 42);
+        static_assert(empty.value_or(7) == 7);
+    }
+}
+
+TEST_CASE("OptionalArray")
+{
+    OptionalArray<int> column = {1, std::nullopt, 3, std::nullopt, 5};
+
+    REQUIRE(column.size() == 5);
+    REQUIRE(column.count() == 3);
+    REQUIRE(column[0] == 1);
+    REQUIRE(column[1] == std::nullopt);
+    REQUIRE(column.value_or(3, -1) == -1);
+    REQUIRE_THROWS_AS(column.value(1), std::bad_optional_access);
+
+    column.set(1, 2);
+    column.reset(4);
+    REQUIRE(column[1] == 2);
+    REQUIRE(column[4] == std::nullopt);
+
+    SECTION("presence bitmap spans many words")
+    {
+        OptionalArray<double> values;
+        for (int i = 0; i < 1000; ++i)
+            values.push_back(i % 3 == 0 ? std::optional{1.0 * i} : std::nullopt);
+
+        REQUIRE(values.count() == 334);
+        REQUIRE(values[999] == 999.0);
+        REQUIRE_FALSE(values.has_value(998));
+    }
+}
+
+TEST_CASE("OptionalArray - proxies and iteration")
+{
+    OptionalArray<int> column = {1, std::nullopt, 3};
+
+    column[1] = 2;
+    column[2] = std::nullopt;
+
+    REQUIRE(column[1] == 2);
+    REQUIRE(column[2] == std::nullopt);
+    REQUIRE(column[0].value_or(0) == 1);
+
+    std::vector<std::optional<int>> items(column.begin(), column.end());
+    REQUIRE(items == std::vector<std::optional<int>>{1, 2, std::nullopt});
+
+    SECTION("assignment from another item copies the value")
+    {
+        column[2] = column[0];
+        column[0] = column[2];
+        column[1] = std::as_const(column)[2];
+        REQUIRE(std::vector(column.begin(), column.end()) == std::vector<std::optional<int>>{1, 1, 1});
+
+        column[0] = OptionalArray<int>{std::nullopt}[0];
+        REQUIRE(column[0] == std::nullopt);
+    }
+
+    SECTION("assignment of std::optional")
+    {
+        std::optional<int> value = 7;
+        std::optional<int> nothing;
+
+        column[2] = value;
+        column[0] = nothing;
+        REQUIRE(std::vector(column.begin(), column.end()) == std::vector<std::optional<int>>{std::nullopt, 2, 7});
+    }
+}
+
+namespace
+{
+    NullableColumn<double> make_column(size_t size, int null_every)
+    {
+        NullableColumn<double> column;
+        column.reserve(size);
+
+        for (size_t i = 0; i < size; ++i)
+            column.push_back(i % null_every == 0 ? std::nullopt : std::optional{1.0 * i});
+
+        return column;
+    }
+}
+
+TEST_CASE("NullableColumn")
+{
+    NullableColumn<double> column = {1.0, std::nullopt, 3.0, std::nullopt, 5.0};
+
+    REQUIRE(column.count_present() == 3);
+    REQUIRE(column.count_null() == 2);
+    REQUIRE(column.sum_present() == 9.0);
+    REQUIRE(column.values_or(-1.0) == std::vector{1.0, -1.0, 3.0, -1.0, 5.0});
+    REQUIRE(column.value_or(1, -1.0) == -1.0); // single item - inherited from OptionalArray
+    REQUIRE(column.value_or(2, -1.0) == 3.0);
+
+    std::vector<double> output(column.size());
+    column.fill_value_or(0.0, output.data());
+    REQUIRE(output == std::vector{1.0, 0.0, 3.0, 0.0, 5.0});
+
+    SECTION("value_or of a single item for integral columns")
+    {
+        NullableColumn<int> ints = {1, std::nullopt, 3};
+
+        REQUIRE(ints.value_or(1, 0) == 0);
+        REQUIRE(ints.value_or(2, 0) == 3);
+        REQUIRE(ints.values_or(0) == std::vector{1, 0, 3});
+    }
+
+    auto large = column.filter([](double x) { return x > 2.0; });
+    REQUIRE(std::vector(large.begin(), large.end()) == std::vector<std::optional<double>>{3.0, 5.0});
+
+    SECTION("results match vector<optional> over many blocks")
+    {
+        const auto column = make_column(1000, 7);
+
+        std::vector<std::optional<double>> reference(column.begin(), column.end());
+
+        REQUIRE(column.count_present() == static_cast<size_t>(std::count_if(reference.begin(), reference.end(), [](auto& x) { return x.has_value(); })));
+
+        const auto values = column.values_or(-1.0);
+        for (size_t i = 0; i < reference.size(); ++i)
+            REQUIRE(values[i] == reference[i].value_or(-1.0));
+
+        double expected_sum = 0.0;
+        for (const auto& item : reference)
+            expected_sum += item.value_or(0.0);
+        REQUIRE(column.sum_present() == Approx(expected_sum));
+
+        const auto even = column.filter([](double x) { return static_cast<int>(x) % 2 == 0; });
+        REQUIRE(even.size() == static_cast<size_t>(std::count_if(reference.begin(), reference.end(), [](auto& x) { return x && static_cast<int>(*x) % 2 == 0; })));
+    }
+
+    SECTION("null slots stay zeroed after reset")
+    {
+        column[0] = std::nullopt;
+        REQUIRE(column.sum_present() == 8.0);
+    }
+}
+
+TEST_CASE("NullableColumn - benchmark", "[.][benchmark]")
+{
+    constexpr size_t size = 1'000'000;
+
+    const auto column = make_column(size, 10);
+    const std::vector<std::optional<double>> optionals(column.begin(), column.end());
+
+    std::vector<double> output(size);
+
+    BENCHMARK("vector<optional> - value_or")
+    {
+        std::transform(optionals.begin(), optionals.end(), output.begin(), [](const auto& x) { return x.value_or(0.0); });
+        return output.back();
+    };
+
+    BENCHMARK("NullableColumn - fill_value_or")
+    {
+        column.fill_value_or(0.0, output.data());
+        return output.back();
+    };
+
+    BENCHMARK("vector<optional> - count_present")
+    {
+        return std::count_if(optionals.begin(), optionals.end(), [](const auto& x) { return x.has_value(); });
+    };
+
+    BENCHMARK("NullableColumn - count_present")
+    {
+        return column.count_present();
+    };
+
+    BENCHMARK("vector<optional> - sum_present")
+    {
+        double sum = 0.0;
+        for (const auto& x : optionals)
+            if (x)
+                sum += *x;
+        return sum;
+    };
+
+    BENCHMARK("NullableColumn - sum_present")
+    {
+        return column.sum_present();
+    };
+}
+
+TEST_CASE("OnceCell - lazily initialized shared state")
+{
+    OnceCell<std::atomic<int>> counter;
+    REQUIRE(counter.get() == nullptr);
+
+    std::atomic<int> init_calls{0};
+    auto init = [&init_calls] {
+        ++init_calls;
+        return 42;
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i)
+        threads.emplace_back([&] {
+            for (int n = 0; n < 1000; ++n)
+                ++counter.get_or_init(init);
+        });
+
+    for (auto& t : threads)
+        t.join();
+
+    REQUIRE(init_calls == 1);
+    REQUIRE(*counter.get() == 42 + 8 * 1000);
+}
+
+TEST_CASE("OnceCell - failed initialization is retried")
+{
+    OnceCell<std::string> cell;
+
+    REQUIRE_THROWS(cell.get_or_init([]() -> std::string { throw std::runtime_error{"no config"}; }));
+    REQUIRE_FALSE(cell.is_initialized());
+
+    REQUIRE(cell.get_or_init([] { return "default_file.cfg"s; }) == "default_file.cfg");
+    REQUIRE(cell.get_or_init([] { return "ignored"s; }) == "default_file.cfg");
+}
+
+TEST_CASE("Lazy")
+{
+    int init_calls = 0;
+    Lazy config_file{[&init_calls] {
+        ++init_calls;
+        return "default_file.cfg"s;
+    }};
+
+    static_assert(std::is_same_v<decltype(*config_file), std::string&>);
+
+    REQUIRE_FALSE(config_file.is_initialized());
+    REQUIRE(config_file->size() == 16);
+    REQUIRE(*config_file == "default_file.cfg");
+    REQUIRE(init_calls == 1);
+}
+
+namespace
+{
+    template <typename F>
+    int read_concurrently(F read, size_t thread_count, int reads_per_thread)
+    {
+        std::atomic<int> total{0};
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < thread_count; ++i)
+            threads.emplace_back([&] {
+                int sum = 0;
+                for (int n = 0; n < reads_per_thread; ++n)
+                    sum += read();
+                total += sum;
+            });
+
+        for (auto& t : threads)
+            t.join();
+
+        return total;
+    }
+
+    int expensive_init()
+    {
+        return 42;
+    }
+}
+
+TEST_CASE("OnceCell - contention benchmark", "[.][benchmark]")
+{
+    constexpr int reads_per_thread = 100'000;
+    const size_t thread_count = std::max(4u, std::thread::hardware_concurrency());
+
+    OnceCell<int> cell;
+
+    std::once_flag flag;
+    int once_value = 0;
+
+    std::mutex mtx;
+    std::optional<int> guarded;
+
+    BENCHMARK("OnceCell::get_or_init")
+    {
+        return read_concurrently([&] { return cell.get_or_init(expensive_init); }, thread_count, reads_per_thread);
+    };
+
+    BENCHMARK("std::call_once")
+    {
+        return read_concurrently([&] {
+            std::call_once(flag, [&] { once_value = expensive_init(); });
+            return once_value;
+        }, thread_count, reads_per_thread);
+    };
+
+    BENCHMARK("mutex + optional")
+    {
+        return read_concurrently([&] {
+            std::lock_guard lk{mtx};
+            if (!guarded)
+                guarded.emplace(expensive_init());
+            return *guarded;
+        }, thread_count, reads_per_thread);
+    };
+}
+
 template <typename TContainer>
 constexpr std::optional<std::string_view> find_id(const TContainer& container, std::string_view id)
 {
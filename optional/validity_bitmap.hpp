@@ -0,0 +1,116 @@
+#ifndef VALIDITY_BITMAP_HPP
+#define VALIDITY_BITMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace BitmapDetails
+{
+    inline size_t popcount(uint64_t word) noexcept
+    {
+#if defined(__GNUC__)
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        size_t count = 0;
+        for (; word != 0; word &= word - 1)
+            ++count;
+        return count;
+#endif
+    }
+}
+
+// packed presence flags - one bit per item; bits past size() are always zero
+class ValidityBitmap
+{
+    std::vector<uint64_t> words_;
+    size_t size_ = 0;
+
+    static constexpr size_t word_count(size_t size) noexcept
+    {
+        return (size + bits_per_word - 1) / bits_per_word;
+    }
+
+    static constexpr uint64_t bit(size_t index) noexcept
+    {
+        return uint64_t{1} << (index % bits_per_word);
+    }
+
+public:
+    static constexpr size_t bits_per_word = 64;
+
+    ValidityBitmap() = default;
+
+    explicit ValidityBitmap(size_t size, bool value = false)
+        : words_(word_count(size), value ? ~uint64_t{0} : 0), size_{size}
+    {
+        if (value && size % bits_per_word != 0)
+            words_.back() = bit(size) - 1;
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    void reserve(size_t capacity)
+    {
+        words_.reserve(word_count(capacity));
+    }
+
+    void clear() noexcept
+    {
+        words_.clear();
+        size_ = 0;
+    }
+
+    void push_back(bool value)
+    {
+        if (size_ % bits_per_word == 0)
+            words_.push_back(0);
+
+        if (value)
+            words_.back() |= bit(size_);
+
+        ++size_;
+    }
+
+    bool test(size_t index) const noexcept
+    {
+        return (words_[index / bits_per_word] & bit(index)) != 0;
+    }
+
+    void set(size_t index, bool value = true) noexcept
+    {
+        if (value)
+            words_[index / bits_per_word] |= bit(index);
+        else
+            words_[index / bits_per_word] &= ~bit(index);
+    }
+
+    void reset(size_t index) noexcept
+    {
+        set(index, false);
+    }
+
+    size_t count() const noexcept
+    {
+        size_t result = 0;
+        for (const uint64_t word : words_)
+            result += BitmapDetails::popcount(word);
+        return result;
+    }
+
+    // raw access for word-at-a-time algorithms
+    const uint64_t* words() const noexcept
+    {
+        return words_.data();
+    }
+
+    size_t word_count() const noexcept
+    {
+        return words_.size();
+    }
+};
+
+#endif // VALIDITY_BITMAP_HPP
@@ -0,0 +1,437 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// vector with inline storage for N elements - heap is used only when size() > N
+template <typename T, size_t N>
+class SmallVector
+{
+    static_assert(N > 0, "inline capacity must be greater than zero");
+
+    T* data_;
+    size_t size_ = 0;
+    size_t capacity_ = N;
+    alignas(T) std::byte buffer_[N * sizeof(T)];
+
+    T* inline_data() noexcept
+    {
+        return std::launder(reinterpret_cast<T*>(buffer_));
+    }
+
+    static constexpr bool move_on_relocate = std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>;
+
+    static void relocate(T* first, T* last, T* dest)
+    {
+        if constexpr (move_on_relocate)
+            std::uninitialized_move(first, last, dest);
+        else
+            std::uninitialized_copy(first, last, dest);
+    }
+
+    void reallocate(size_t new_capacity)
+    {
+        T* new_data = std::allocator<T>{}.allocate(new_capacity);
+
+        try
+        {
+            relocate(data_, data_ + size_, new_data);
+        }
+        catch (...)
+        {
+            std::allocator<T>{}.deallocate(new_data, new_capacity);
+            throw;
+        }
+
+        std::destroy(data_, data_ + size_);
+        release_heap();
+
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    void release_heap() noexcept
+    {
+        if (!is_inline())
+            std::allocator<T>{}.deallocate(data_, capacity_);
+    }
+
+    size_t next_capacity() const noexcept
+    {
+        return capacity_ * 2;
+    }
+
+    void steal_or_move_from(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (other.is_inline())
+        {
+            std::uninitialized_move(other.data_, other.data_ + other.size_, data_);
+            size_ = other.size_;
+            other.clear();
+        }
+        else
+        {
+            data_ = std::exchange(other.data_, other.inline_data());
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, N);
+        }
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_t inline_capacity = N;
+
+    SmallVector() noexcept
+        : data_{inline_data()}
+    {
+    }
+
+    explicit SmallVector(size_t count)
+        : SmallVector()
+    {
+        resize(count);
+    }
+
+    SmallVector(size_t count, const T& value)
+        : SmallVector()
+    {
+        reserve(count);
+        std::uninitialized_fill_n(data_, count, value);
+        size_ = count;
+    }
+
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    SmallVector(InputIt first, InputIt last)
+        : SmallVector()
+    {
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+            reserve(static_cast<size_t>(std::distance(first, last)));
+
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
+    SmallVector(std::initializer_list<T> il)
+        : SmallVector(il.begin(), il.end())
+    {
+    }
+
+    SmallVector(const SmallVector& source)
+        : SmallVector(source.begin(), source.end())
+    {
+    }
+
+    SmallVector(SmallVector&& source) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : SmallVector()
+    {
+        steal_or_move_from(source);
+    }
+
+    SmallVector& operator=(const SmallVector& source)
+    {
+        if (this != &source)
+        {
+            SmallVector temp(source);
+            swap(temp);
+        }
+
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& source) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &source)
+        {
+            clear();
+            release_heap();
+            data_ = inline_data();
+            capacity_ = N;
+
+            steal_or_move_from(source);
+        }
+
+        return *this;
+    }
+
+    SmallVector& operator=(std::initializer_list<T> il)
+    {
+        SmallVector temp(il);
+        swap(temp);
+
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        clear();
+        release_heap();
+    }
+
+    void swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        SmallVector temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    bool is_inline() const noexcept
+    {
+        return data_ == reinterpret_cast<const T*>(buffer_);
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    T* data() noexcept
+    {
+        return data_;
+    }
+
+    const T* data() const noexcept
+    {
+        return data_;
+    }
+
+    iterator begin() noexcept
+    {
+        return data_;
+    }
+
+    iterator end() noexcept
+    {
+        return data_ + size_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    T& operator[](size_t index)
+    {
+        return data_[index];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return data_[index];
+    }
+
+    T& at(size_t index)
+    {
+        if (index >= size_)
+            throw std::out_of_range("SmallVector::at - index out of range");
+
+        return data_[index];
+    }
+
+    const T& at(size_t index) const
+    {
+        return const_cast<SmallVector&>(*this).at(index);
+    }
+
+    T& front()
+    {
+        return data_[0];
+    }
+
+    const T& front() const
+    {
+        return data_[0];
+    }
+
+    T& back()
+    {
+        return data_[size_ - 1];
+    }
+
+    const T& back() const
+    {
+        return data_[size_ - 1];
+    }
+
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity > capacity_)
+            reallocate(new_capacity);
+    }
+
+    template <typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        if (size_ == capacity_)
+        {
+            // new item is constructed before relocation - args may refer to items of this container
+            SmallVector grown;
+            grown.reserve(next_capacity());
+            ::new (static_cast<void*>(grown.data_ + size_)) T(std::forward<TArgs>(args)...);
+
+            try
+            {
+                relocate(data_, data_ + size_, grown.data_);
+            }
+            catch (...)
+            {
+                std::destroy_at(grown.data_ + size_);
+                throw;
+            }
+
+            grown.size_ = size_ + 1;
+            clear();
+            release_heap();
+
+            data_ = std::exchange(grown.data_, grown.inline_data());
+            size_ = std::exchange(grown.size_, 0);
+            capacity_ = std::exchange(grown.capacity_, N);
+        }
+        else
+        {
+            ::new (static_cast<void*>(data_ + size_)) T(std::forward<TArgs>(args)...);
+            ++size_;
+        }
+
+        return back();
+    }
+
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    void pop_back()
+    {
+        std::destroy_at(data_ + --size_);
+    }
+
+    void resize(size_t new_size)
+    {
+        if (new_size < size_)
+        {
+            std::destroy(data_ + new_size, data_ + size_);
+        }
+        else
+        {
+            reserve(new_size);
+            std::uninitialized_value_construct(data_ + size_, data_ + new_size);
+        }
+
+        size_ = new_size;
+    }
+
+    void clear() noexcept
+    {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+};
+
+template <typename T, size_t N>
+bool operator==(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs)
+{
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, size_t N>
+bool operator!=(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename T, size_t N>
+void swap(SmallVector<T, N>& lhs, SmallVector<T, N>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+// inline capacity deduced for vectors built from a range or a count
+inline constexpr size_t small_vector_default_capacity = 8;
+
+namespace SmallVectorDetails
+{
+    template <typename T, typename = void>
+    constexpr bool is_iterator_v = false;
+
+    template <typename T>
+    constexpr bool is_iterator_v<T, std::void_t<typename std::iterator_traits<T>::iterator_category>> = true;
+
+    // (first, last) and (size_t count, value) are constructor calls - not lists of two items
+    template <typename T1, typename T2, typename... Ts>
+    constexpr bool is_item_list_v = sizeof...(Ts) > 0
+        || !((is_iterator_v<T1> && std::is_same_v<T1, T2>) || std::is_same_v<T1, size_t>);
+}
+
+// deduction guides:
+// - SmallVector v{1, 2, 3} - inline capacity equals the number of items; at least two items are required,
+//   so SmallVector v(5) is not deduced as a one-item vector (use SmallVector<T, N> v(5) or make_small_vector(5))
+// - SmallVector v(first, last) and SmallVector v(size_t{3}, value) - default inline capacity
+//   (a count of type int is taken as an item - SmallVector v(3, 42) holds 3 and 42)
+template <typename T1, typename T2, typename... Ts,
+    typename = std::enable_if_t<SmallVectorDetails::is_item_list_v<T1, T2, Ts...>>>
+SmallVector(T1, T2, Ts...) -> SmallVector<std::common_type_t<T1, T2, Ts...>, 2 + sizeof...(Ts)>;
+
+template <typename InputIt, typename = std::enable_if_t<SmallVectorDetails::is_iterator_v<InputIt>>>
+SmallVector(InputIt, InputIt) -> SmallVector<typename std::iterator_traits<InputIt>::value_type, small_vector_default_capacity>;
+
+template <typename T>
+SmallVector(size_t, T) -> SmallVector<T, small_vector_default_capacity>;
+
+template <typename... Ts>
+SmallVector<std::common_type_t<Ts...>, sizeof...(Ts)> make_small_vector(Ts&&... args)
+{
+    SmallVector<std::common_type_t<Ts...>, sizeof...(Ts)> ret_val;
+
+    (..., ret_val.push_back(std::forward<Ts>(args)));
+
+    return ret_val;
+}
+
+#endif // SMALL_VECTOR_HPP
@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch.hpp"
+#include "../_common/allocation_counter.hpp"
+#include "small_vector.hpp"
+
+using namespace std;
+
+TEST_CASE("SmallVector - inline storage")
+{
+    SmallVector<int, 4> vec;
+
+    REQUIRE(vec.empty());
+    REQUIRE(vec.capacity() == 4);
+
+    auto allocations = count_allocations([&vec] {
+        for (int i = 1; i <= 4; ++i)
+            vec.push_back(i);
+    });
+
+    REQUIRE(allocations == 0);
+    REQUIRE(vec.is_inline());
+    REQUIRE(vec.size() == 4);
+    REQUIRE(std::accumulate(vec.begin(), vec.end(), 0) == 10);
+
+    SECTION("spills to heap when inline capacity is exceeded")
+    {
+        vec.push_back(5);
+
+        REQUIRE_FALSE(vec.is_inline());
+        REQUIRE(vec.capacity() == 8);
+        REQUIRE(vec == SmallVector<int, 4>{1, 2, 3, 4, 5});
+    }
+
+    SECTION("push_back of own item when full")
+    {
+        vec.push_back(vec[0]);
+
+        REQUIRE(vec.back() == 1);
+    }
+
+    SECTION("at")
+    {
+        REQUIRE(vec.at(3) == 4);
+        REQUIRE_THROWS_AS(vec.at(4), std::out_of_range);
+    }
+}
+
+TEST_CASE("SmallVector - copy & move semantics")
+{
+    using Strings = SmallVector<string, 2>;
+
+    static_assert(std::is_nothrow_move_constructible_v<Strings>);
+    static_assert(std::is_nothrow_move_assignable_v<Strings>);
+
+    SECTION("inline")
+    {
+        Strings source{"one", "two"};
+
+        Strings copy = source;
+        REQUIRE(copy == source);
+
+        Strings target = std::move(source);
+        REQUIRE(target == copy);
+        REQUIRE(target.is_inline());
+        REQUIRE(source.empty());
+    }
+
+    SECTION("heap")
+    {
+        Strings source{"one", "two", "three"};
+        const string* items = source.data();
+
+        Strings copy;
+        copy = source;
+        REQUIRE(copy == source);
+
+        Strings target;
+        target = std::move(source);
+        REQUIRE(target.data() == items); // buffer is stolen
+        REQUIRE(target == copy);
+        REQUIRE(source.empty());
+        REQUIRE(source.is_inline());
+    }
+
+    SECTION("move-only types")
+    {
+        SmallVector<unique_ptr<int>, 2> ptrs;
+        ptrs.push_back(make_unique<int>(1));
+        ptrs.push_back(make_unique<int>(2));
+        ptrs.emplace_back(new int(3));
+
+        auto target = std::move(ptrs);
+        REQUIRE(*target[2] == 3);
+    }
+
+    SECTION("swap")
+    {
+        Strings a{"a"};
+        Strings b{"b1", "b2", "b3"};
+
+        swap(a, b);
+
+        REQUIRE(a.size() == 3);
+        REQUIRE(b == Strings{"a"});
+    }
+}
+
+TEST_CASE("SmallVector - resize")
+{
+    SmallVector<int, 2> vec(3);
+
+    REQUIRE(vec == SmallVector<int, 2>{0, 0, 0});
+
+    vec.resize(1);
+    REQUIRE(vec.size() == 1);
+
+    SmallVector<int, 2> filled(3, 42);
+    REQUIRE(std::all_of(filled.begin(), filled.end(), [](int x) { return x == 42; }));
+}
+
+template <typename... Ts>
+auto deduce_small_vector(int) -> decltype(SmallVector{std::declval<Ts>()...}, std::true_type{});
+
+template <typename...>
+std::false_type deduce_small_vector(...);
+
+template <typename... Ts>
+constexpr bool is_deducible_from_v = decltype(deduce_small_vector<Ts...>(0))::value;
+
+TEST_CASE("SmallVector - CTAD")
+{
+    SmallVector vec1{1, 2, 3}; // SmallVector<int, 3>
+    static_assert(std::is_same_v<decltype(vec1), SmallVector<int, 3>>);
+
+    SmallVector vec2{1, 2.5}; // SmallVector<double, 2>
+    static_assert(std::is_same_v<decltype(vec2), SmallVector<double, 2>>);
+
+    SmallVector vec3 = vec1; // copy - SmallVector<int, 3>
+    static_assert(std::is_same_v<decltype(vec3), SmallVector<int, 3>>);
+
+    // a single argument is a count (as for std::vector) - N cannot be deduced from it
+    static_assert(!is_deducible_from_v<int>);
+    static_assert(!is_deducible_from_v<size_t>);
+    static_assert(is_deducible_from_v<int, int>);
+
+    SmallVector<int, 8> counted(5);
+    REQUIRE(counted.size() == 5);
+    REQUIRE(std::all_of(counted.begin(), counted.end(), [](int x) { return x == 0; }));
+
+    auto single = make_small_vector(5); // SmallVector<int, 1> holding 5
+    REQUIRE(single.size() == 1);
+    REQUIRE(single[0] == 5);
+
+    SECTION("iterator pair")
+    {
+        std::vector<std::string> words = {"one", "two", "three"};
+
+        SmallVector from_range(words.begin(), words.end());
+        static_assert(std::is_same_v<decltype(from_range), SmallVector<std::string, small_vector_default_capacity>>);
+        REQUIRE(std::equal(from_range.begin(), from_range.end(), words.begin(), words.end()));
+
+        const int items[] = {1, 2, 3, 4};
+        SmallVector from_pointers(std::begin(items), std::end(items));
+        static_assert(std::is_same_v<decltype(from_pointers), SmallVector<int, small_vector_default_capacity>>);
+        REQUIRE(from_pointers.size() == 4);
+    }
+
+    SECTION("count and value")
+    {
+        size_t count = 3;
+
+        SmallVector filled(count, 42);
+        static_assert(std::is_same_v<decltype(filled), SmallVector<int, small_vector_default_capacity>>);
+        REQUIRE(filled.size() == 3);
+        REQUIRE(std::all_of(filled.begin(), filled.end(), [](int x) { return x == 42; }));
+
+        SmallVector texts(2, std::string("text")); // no common type - 2 is a count
+        static_assert(std::is_same_v<decltype(texts), SmallVector<std::string, small_vector_default_capacity>>);
+        REQUIRE(texts.size() == 2);
+        REQUIRE(texts[1] == "text");
+    }
+}
+
+TEST_CASE("make_small_vector")
+{
+    size_t allocations = count_allocations([] {
+        auto vec = make_small_vector(1, 2, 3, 4);
+        static_assert(std::is_same_v<decltype(vec), SmallVector<int, 4>>);
+        REQUIRE(vec.back() == 4);
+    });
+
+    REQUIRE(allocations == 0);
+}
+
+TEST_CASE("SmallVector - allocations vs. std::vector")
+{
+    for (int size : {1, 4, 8, 16})
+    {
+        auto small_vector_allocations = count_allocations([size] {
+            SmallVector<int, 8> vec;
+            for (int i = 0; i < size; ++i)
+                vec.push_back(i);
+        });
+
+        auto vector_allocations = count_allocations([size] {
+            std::vector<int> vec;
+            for (int i = 0; i < size; ++i)
+                vec.push_back(i);
+        });
+
+        REQUIRE(small_vector_allocations <= vector_allocations);
+    }
+}
+
+template <typename TContainer>
+int fill_and_sum(int size)
+{
+    TContainer vec;
+    for (int i = 0; i < size; ++i)
+        vec.push_back(i);
+    return std::accumulate(vec.begin(), vec.end(), 0);
+}
+
+TEST_CASE("SmallVector - benchmark", "[.][benchmark]")
+{
+    for (int size : {2, 4, 8, 16, 64})
+    {
+        BENCHMARK("std::vector<int> - " + to_string(size) + " items")
+        {
+            return fill_and_sum<std::vector<int>>(size);
+        };
+
+        BENCHMARK("SmallVector<int, 8> - " + to_string(size) + " items")
+        {
+            return fill_and_sum<SmallVector<int, 8>>(size);
+        };
+    }
+}
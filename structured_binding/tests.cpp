@@ -5,6 +5,7 @@
 #include <map>
 #include <numeric>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -218,8 +219,33 @@ enum Something
     some, thing
 };
 
-const std::map<Something, std::string_view> something_desc = {
-    { some, "some"sv}, {thing, "thing"sv}
+////////////////////////////////////////
+// compile-time enum reflection
+
+// EnumNames<E>::values must list the names of enumerators 0, 1, ..., N-1
+template <typename TEnum>
+struct EnumNames;
+
+template <typename TEnum>
+constexpr std::string_view unknown_enum_name = "<unknown>"sv;
+
+template <typename TEnum>
+constexpr std::string_view enum_to_string(TEnum value)
+{
+    static_assert(std::is_enum_v<TEnum>);
+
+    constexpr auto& names = EnumNames<TEnum>::values;
+
+    // negative values wrap around to huge indexes - one comparison covers both bounds
+    const auto index = static_cast<size_t>(static_cast<std::underlying_type_t<TEnum>>(value));
+
+    return index < std::size(names) ? names[index] : unknown_enum_name<TEnum>;
+}
+
+template <>
+struct EnumNames<Something>
+{
+    static constexpr std::array values = { "some"sv, "thing"sv };
 };
 
 // step 1 - std::tuple_size<Something>
@@ -241,7 +267,7 @@ struct std::tuple_element<1, Something> {
 
 // step 3 - get<Index>
 template <size_t Index>
-decltype(auto) get(const Something& sth)
+constexpr decltype(auto) get(const Something& sth)
 {
     if constexpr(Index == 0)
     {
@@ -249,7 +275,7 @@ decltype(auto) get(const Something& sth)
     }
     else 
     {
-        return something_desc.at(sth);
+        return enum_to_string(sth);
     }
 }
 
@@ -262,7 +288,7 @@ decltype(auto) get(const Something& sth)
 // template <>
 // decltype(auto) get<1>(const Something& sth)
 // {
-//     return something_desc.at(sth);
+//     return enum_to_string(sth);
 // }
 
 TEST_CASE("Structured binding for Something")
@@ -273,4 +299,37 @@ TEST_CASE("Structured binding for Something")
 
     REQUIRE(value == 0);
     REQUIRE(description == "some"sv);
+}
+
+enum class Priority : int
+{
+    low, high
+};
+
+template <>
+struct EnumNames<Priority>
+{
+    static constexpr std::array values = { "low"sv, "high"sv };
+};
+
+TEST_CASE("enum_to_string")
+{
+    static_assert(enum_to_string(some) == "some"sv);
+    static_assert(enum_to_string(thing) == "thing"sv);
+    static_assert(enum_to_string(Priority::high) == "high"sv);
+
+    SECTION("out of range values")
+    {
+        REQUIRE(enum_to_string(static_cast<Priority>(2)) == "<unknown>"sv);
+        REQUIRE(enum_to_string(static_cast<Priority>(-1)) == "<unknown>"sv);
+    }
+
+    SECTION("structured binding in constexpr context")
+    {
+        constexpr auto value = get<0>(thing);
+        constexpr auto description = get<1>(thing);
+
+        static_assert(value == 1);
+        static_assert(description == "thing"sv);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,315 @@
+#ifndef COMPACT_VARIANT_HPP
+#define COMPACT_VARIANT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace CompactVariantDetails
+{
+    template <size_t N>
+    using smallest_index_t = std::conditional_t<(N <= UINT8_MAX), uint8_t,
+                             std::conditional_t<(N <= UINT16_MAX), uint16_t, uint32_t>>;
+
+    template <typename T, typename... Ts>
+    constexpr size_t index_of()
+    {
+        constexpr bool matches[] = {std::is_same_v<T, Ts>...};
+
+        size_t index = 0;
+        while (index < sizeof...(Ts) && !matches[index])
+            ++index;
+
+        return index;
+    }
+
+    template <typename T, typename... Ts>
+    constexpr bool is_alternative_v = (... + std::is_same_v<T, Ts>) == 1;
+
+    template <size_t Index, typename... Ts>
+    using alternative_t = std::variant_alternative_t<Index, std::variant<Ts...>>;
+
+    template <typename T>
+    constexpr size_t pointee_alignment()
+    {
+        if constexpr (std::is_pointer_v<T> && !std::is_void_v<std::remove_pointer_t<T>> && !std::is_function_v<std::remove_pointer_t<T>>)
+            return alignof(std::remove_pointer_t<T>);
+        else
+            return 1;
+    }
+
+    // low bits of pointers are always zero when the pointee alignment is large enough to hold the index
+    template <typename... Ts>
+    constexpr bool index_fits_in_pointer_bits_v = (... && (std::is_pointer_v<Ts> && pointee_alignment<Ts>() >= sizeof...(Ts)));
+}
+
+// variant of trivially copyable types with the smallest index type and no padding:
+// - pointers to types with sufficient alignment - the index is stored in the unused low bits (sizeof == sizeof(void*))
+// - other types - payload is stored unaligned (byte-packed) and accessed with memcpy (sizeof == max payload + index)
+template <typename... Ts>
+class CompactVariant
+{
+    static_assert(sizeof...(Ts) > 0);
+    static_assert((... && std::is_trivially_copyable_v<Ts>), "CompactVariant supports only trivially copyable types");
+
+public:
+    using index_type = CompactVariantDetails::smallest_index_t<sizeof...(Ts)>;
+
+    static constexpr bool uses_pointer_tag = CompactVariantDetails::index_fits_in_pointer_bits_v<Ts...>;
+
+private:
+    static constexpr size_t payload_size = std::max({sizeof(Ts)...});
+    static constexpr uintptr_t tag_mask = uses_pointer_tag ? std::min({CompactVariantDetails::pointee_alignment<Ts>()...}) - 1 : 0;
+
+    struct PackedStorage
+    {
+        unsigned char payload[payload_size];
+        index_type index;
+    };
+
+    std::conditional_t<uses_pointer_tag, uintptr_t, PackedStorage> storage_;
+
+    template <typename T>
+    static constexpr size_t index_of = CompactVariantDetails::index_of<T, Ts...>();
+
+    template <size_t Index, typename TVisitor>
+    static decltype(auto) visit_at(const CompactVariant& v, TVisitor&& visitor)
+    {
+        return std::forward<TVisitor>(visitor)(v.get<CompactVariantDetails::alternative_t<Index, Ts...>>());
+    }
+
+    template <typename TVisitor, size_t... Is>
+    decltype(auto) visit_impl(TVisitor&& visitor, std::index_sequence<Is...>) const
+    {
+        using Result = std::invoke_result_t<TVisitor, CompactVariantDetails::alternative_t<0, Ts...>>;
+        using Invoker = Result (*)(const CompactVariant&, TVisitor&&);
+
+        static constexpr Invoker invokers[] = {&visit_at<Is, TVisitor>...};
+
+        return invokers[index()](*this, std::forward<TVisitor>(visitor));
+    }
+
+public:
+    CompactVariant() noexcept
+        : CompactVariant(CompactVariantDetails::alternative_t<0, Ts...>{})
+    {
+    }
+
+    template <typename T, typename = std::enable_if_t<CompactVariantDetails::is_alternative_v<std::decay_t<T>, Ts...>>>
+    CompactVariant(const T& value) noexcept
+    {
+        emplace(value);
+    }
+
+    template <typename T>
+    void emplace(const T& value) noexcept
+    {
+        static_assert(CompactVariantDetails::is_alternative_v<T, Ts...>);
+
+        if constexpr (uses_pointer_tag)
+        {
+            storage_ = reinterpret_cast<uintptr_t>(value) | index_of<T>;
+        }
+        else
+        {
+            std::memcpy(storage_.payload, &value, sizeof(T));
+            storage_.index = static_cast<index_type>(index_of<T>);
+        }
+    }
+
+    size_t index() const noexcept
+    {
+        if constexpr (uses_pointer_tag)
+            return storage_ & tag_mask;
+        else
+            return storage_.index;
+    }
+
+    template <typename T>
+    bool holds_alternative() const noexcept
+    {
+        return index() == index_of<T>;
+    }
+
+    // returns copy of the value - payload may be unaligned
+    template <typename T>
+    T get() const
+    {
+        static_assert(CompactVariantDetails::is_alternative_v<T, Ts...>);
+
+        if (!holds_alternative<T>())
+            throw std::bad_variant_access{};
+
+        if constexpr (uses_pointer_tag)
+        {
+            return reinterpret_cast<T>(storage_ & ~tag_mask);
+        }
+        else
+        {
+            T value;
+            std::memcpy(&value, storage_.payload, sizeof(T));
+            return value;
+        }
+    }
+
+    template <typename TVisitor>
+    decltype(auto) visit(TVisitor&& visitor) const
+    {
+        return visit_impl(std::forward<TVisitor>(visitor), std::index_sequence_for<Ts...>{});
+    }
+};
+
+// structure of arrays - discriminators, offsets and payloads are stored in separate vectors:
+// - the payload of each alternative lives in its own std::vector<T> (any movable type - not only trivially copyable)
+// - item at a position = segment of type indexes_[position], item offsets_[position] in that segment
+// scans by type touch only the (small) discriminator array or a single segment
+template <typename... Ts>
+class VariantVector
+{
+    static_assert(sizeof...(Ts) > 0);
+    static_assert((... && CompactVariantDetails::is_alternative_v<Ts, Ts...>), "VariantVector - alternatives must be distinct types");
+
+public:
+    using index_type = CompactVariantDetails::smallest_index_t<sizeof...(Ts)>;
+
+private:
+    std::vector<index_type> indexes_;
+    std::vector<size_t> offsets_;
+    std::tuple<std::vector<Ts>...> segments_;
+
+    template <typename T>
+    static constexpr size_t index_of = CompactVariantDetails::index_of<T, Ts...>();
+
+    template <typename T>
+    std::vector<T>& segment()
+    {
+        return std::get<std::vector<T>>(segments_);
+    }
+
+    template <typename T>
+    const std::vector<T>& segment() const
+    {
+        return std::get<std::vector<T>>(segments_);
+    }
+
+    template <typename T>
+    const T& get_unchecked(size_t position) const
+    {
+        return segment<T>()[offsets_[position]];
+    }
+
+    template <size_t Index, typename TVisitor>
+    static decltype(auto) visit_at(const VariantVector& vec, size_t position, TVisitor&& visitor)
+    {
+        return std::forward<TVisitor>(visitor)(vec.get_unchecked<CompactVariantDetails::alternative_t<Index, Ts...>>(position));
+    }
+
+    template <typename TVisitor, size_t... Is>
+    decltype(auto) visit_impl(size_t position, TVisitor&& visitor, std::index_sequence<Is...>) const
+    {
+        using Result = std::invoke_result_t<TVisitor, const CompactVariantDetails::alternative_t<0, Ts...>&>;
+        using Invoker = Result (*)(const VariantVector&, size_t, TVisitor&&);
+
+        static constexpr Invoker invokers[] = {&visit_at<Is, TVisitor>...};
+
+        return invokers[indexes_[position]](*this, position, std::forward<TVisitor>(visitor));
+    }
+
+public:
+    template <typename T>
+    void push_back(T&& value)
+    {
+        using U = std::decay_t<T>;
+        static_assert(CompactVariantDetails::is_alternative_v<U, Ts...>);
+
+        emplace_back<U>(std::forward<T>(value));
+    }
+
+    // strong guarantee - nothing is added when any of the vectors throws
+    template <typename T, typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        static_assert(CompactVariantDetails::is_alternative_v<T, Ts...>);
+
+        indexes_.reserve(indexes_.size() + 1);
+        offsets_.reserve(offsets_.size() + 1);
+
+        std::vector<T>& items = segment<T>();
+        T& item = items.emplace_back(std::forward<TArgs>(args)...);
+
+        offsets_.push_back(items.size() - 1); // capacity is reserved - no throw
+        indexes_.push_back(static_cast<index_type>(index_of<T>));
+
+        return item;
+    }
+
+    void reserve(size_t capacity)
+    {
+        indexes_.reserve(capacity);
+        offsets_.reserve(capacity);
+    }
+
+    // reserves space in the segment of type T only
+    template <typename T>
+    void reserve(size_t capacity)
+    {
+        segment<T>().reserve(capacity);
+    }
+
+    size_t size() const noexcept
+    {
+        return indexes_.size();
+    }
+
+    size_t index(size_t position) const
+    {
+        return indexes_[position];
+    }
+
+    template <typename T>
+    const T* get_if(size_t position) const
+    {
+        return indexes_[position] == index_of<T> ? &get_unchecked<T>(position) : nullptr;
+    }
+
+    template <typename TVisitor>
+    decltype(auto) visit(size_t position, TVisitor&& visitor) const
+    {
+        return visit_impl(position, std::forward<TVisitor>(visitor), std::index_sequence_for<Ts...>{});
+    }
+
+    template <typename T>
+    size_t count() const noexcept
+    {
+        return segment<T>().size();
+    }
+
+    // positions of all items of type T - scans only the discriminator array
+    template <typename T>
+    std::vector<size_t> positions_of() const
+    {
+        std::vector<size_t> positions;
+
+        for (size_t i = 0; i < indexes_.size(); ++i)
+            if (indexes_[i] == index_of<T>)
+                positions.push_back(i);
+
+        return positions;
+    }
+
+    // calls f(const T&) for all items of type T (in order of insertion) - scans only the segment of T
+    template <typename T, typename F>
+    void for_each_of_type(F f) const
+    {
+        for (const T& item : segment<T>())
+            f(item);
+    }
+};
+
+#endif // COMPACT_VARIANT_HPP
@@ -0,0 +1,391 @@
+#ifndef EXPECTED_HPP
+#define EXPECTED_HPP
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename E>
+class Unexpected
+{
+    E error_;
+
+public:
+    explicit Unexpected(E error)
+        : error_{std::move(error)}
+    {
+    }
+
+    const E& error() const&
+    {
+        return error_;
+    }
+
+    E&& error() &&
+    {
+        return std::move(error_);
+    }
+};
+
+template <typename E>
+Unexpected(E) -> Unexpected<E>;
+
+class BadExpectedAccess : public std::exception
+{
+public:
+    const char* what() const noexcept override
+    {
+        return "bad Expected access - Expected holds an error";
+    }
+};
+
+namespace ExpectedDetails
+{
+    struct ErrorTag
+    {
+    };
+
+    template <typename T, typename E>
+    constexpr bool is_trivial_v = std::is_trivially_copyable_v<T> && std::is_trivially_copyable_v<E>
+                                  && std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<E>;
+
+    // trivially copyable layout - all special members are defaulted
+    template <typename T, typename E, bool IsTrivial = is_trivial_v<T, E>>
+    struct Storage
+    {
+        union
+        {
+            T value_;
+            E error_;
+        };
+        bool has_value_;
+
+        template <typename... TArgs>
+        explicit Storage(std::in_place_t, TArgs&&... args)
+            : value_(std::forward<TArgs>(args)...), has_value_{true}
+        {
+        }
+
+        template <typename... TArgs>
+        explicit Storage(ErrorTag, TArgs&&... args)
+            : error_(std::forward<TArgs>(args)...), has_value_{false}
+        {
+        }
+    };
+
+    template <typename T, typename E>
+    struct Storage<T, E, false>
+    {
+        union
+        {
+            T value_;
+            E error_;
+        };
+        bool has_value_;
+
+        template <typename... TArgs>
+        explicit Storage(std::in_place_t, TArgs&&... args)
+            : value_(std::forward<TArgs>(args)...), has_value_{true}
+        {
+        }
+
+        template <typename... TArgs>
+        explicit Storage(ErrorTag, TArgs&&... args)
+            : error_(std::forward<TArgs>(args)...), has_value_{false}
+        {
+        }
+
+        Storage(const Storage& other)
+            : has_value_{other.has_value_}
+        {
+            if (has_value_)
+                ::new (std::addressof(value_)) T(other.value_);
+            else
+                ::new (std::addressof(error_)) E(other.error_);
+        }
+
+        Storage(Storage&& other) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E>)
+            : has_value_{other.has_value_}
+        {
+            if (has_value_)
+                ::new (std::addressof(value_)) T(std::move(other.value_));
+            else
+                ::new (std::addressof(error_)) E(std::move(other.error_));
+        }
+
+        // as std::expected - member-wise assignment when the state does not change, otherwise the new member
+        // is constructed so that an exception leaves the old one alive (one of T, E must be nothrow movable)
+        Storage& operator=(const Storage& other)
+        {
+            if (this != &other)
+                assign(other.has_value_, other.value_, other.error_);
+
+            return *this;
+        }
+
+        Storage& operator=(Storage&& other) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>
+                                                     && std::is_nothrow_move_constructible_v<E> && std::is_nothrow_move_assignable_v<E>)
+        {
+            if (this != &other)
+                assign(other.has_value_, std::move(other.value_), std::move(other.error_));
+
+            return *this;
+        }
+
+        ~Storage()
+        {
+            destroy();
+        }
+
+    private:
+        void destroy() noexcept
+        {
+            if (has_value_)
+                std::destroy_at(std::addressof(value_));
+            else
+                std::destroy_at(std::addressof(error_));
+        }
+
+        // TValue/TError - the other storage's members (only the active one is touched)
+        template <typename TValue, typename TError>
+        void assign(bool other_has_value, TValue&& other_value, TError&& other_error)
+        {
+            static_assert(std::is_nothrow_move_constructible_v<T> || std::is_nothrow_move_constructible_v<E>,
+                "Expected - assignment requires T or E to be nothrow move constructible");
+
+            if (has_value_ && other_has_value)
+                value_ = std::forward<TValue>(other_value);
+            else if (!has_value_ && !other_has_value)
+                error_ = std::forward<TError>(other_error);
+            else if (other_has_value)
+            {
+                reinit(value_, error_, std::forward<TValue>(other_value));
+                has_value_ = true;
+            }
+            else
+            {
+                reinit(error_, value_, std::forward<TError>(other_error));
+                has_value_ = false;
+            }
+        }
+
+        // destroys old_member and constructs new_member from source - if that throws, old_member is alive again
+        template <typename TNew, typename TOld, typename TSource>
+        static void reinit(TNew& new_member, TOld& old_member, TSource&& source)
+        {
+            if constexpr (std::is_nothrow_constructible_v<TNew, TSource&&>)
+            {
+                std::destroy_at(std::addressof(old_member));
+                ::new (std::addressof(new_member)) TNew(std::forward<TSource>(source));
+            }
+            else if constexpr (std::is_nothrow_move_constructible_v<TNew>)
+            {
+                TNew temp(std::forward<TSource>(source));
+                std::destroy_at(std::addressof(old_member));
+                ::new (std::addressof(new_member)) TNew(std::move(temp));
+            }
+            else
+            {
+                TOld temp(std::move(old_member));
+                std::destroy_at(std::addressof(old_member));
+
+                try
+                {
+                    ::new (std::addressof(new_member)) TNew(std::forward<TSource>(source));
+                }
+                catch (...)
+                {
+                    ::new (std::addressof(old_member)) TOld(std::move(temp));
+                    throw;
+                }
+            }
+        }
+    };
+}
+
+// value or error - checking for an error is a single test of a flag (no visitation, no exceptions)
+template <typename T, typename E>
+class [[nodiscard]] Expected : private ExpectedDetails::Storage<T, E>
+{
+    using Base = ExpectedDetails::Storage<T, E>;
+
+public:
+    using value_type = T;
+    using error_type = E;
+
+    template <typename U = T, typename = std::enable_if_t<std::is_constructible_v<T, U&&> && !std::is_same_v<std::decay_t<U>, Expected>>>
+    Expected(U&& value)
+        : Base(std::in_place, std::forward<U>(value))
+    {
+    }
+
+    template <typename... TArgs>
+    explicit Expected(std::in_place_t, TArgs&&... args)
+        : Base(std::in_place, std::forward<TArgs>(args)...)
+    {
+    }
+
+    template <typename G>
+    Expected(const Unexpected<G>& unexpected)
+        : Base(ExpectedDetails::ErrorTag{}, unexpected.error())
+    {
+    }
+
+    template <typename G>
+    Expected(Unexpected<G>&& unexpected)
+        : Base(ExpectedDetails::ErrorTag{}, std::move(unexpected).error())
+    {
+    }
+
+    bool has_value() const noexcept
+    {
+        return this->has_value_;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    // unchecked access
+    T& operator*() & noexcept
+    {
+        return this->value_;
+    }
+
+    const T& operator*() const& noexcept
+    {
+        return this->value_;
+    }
+
+    T&& operator*() && noexcept
+    {
+        return std::move(this->value_);
+    }
+
+    T* operator->() noexcept
+    {
+        return std::addressof(this->value_);
+    }
+
+    const T* operator->() const noexcept
+    {
+        return std::addressof(this->value_);
+    }
+
+    // checked access - throws only when an error is stored
+    T& value() &
+    {
+        check_value();
+        return this->value_;
+    }
+
+    const T& value() const&
+    {
+        check_value();
+        return this->value_;
+    }
+
+    T&& value() &&
+    {
+        check_value();
+        return std::move(this->value_);
+    }
+
+    const E& error() const& noexcept
+    {
+        return this->error_;
+    }
+
+    E&& error() && noexcept
+    {
+        return std::move(this->error_);
+    }
+
+    template <typename U>
+    T value_or(U&& default_value) const&
+    {
+        return has_value() ? this->value_ : static_cast<T>(std::forward<U>(default_value));
+    }
+
+    // f(T) -> Expected<U, E>
+    template <typename F>
+    auto and_then(F&& f) const&
+    {
+        using Result = std::invoke_result_t<F, const T&>;
+
+        if (has_value())
+            return std::invoke(std::forward<F>(f), this->value_);
+
+        return Result{Unexpected{this->error_}};
+    }
+
+    template <typename F>
+    auto and_then(F&& f) &&
+    {
+        using Result = std::invoke_result_t<F, T&&>;
+
+        if (has_value())
+            return std::invoke(std::forward<F>(f), std::move(this->value_));
+
+        return Result{Unexpected{std::move(this->error_)}};
+    }
+
+    // f(T) -> U  gives Expected<U, E>
+    template <typename F>
+    auto map(F&& f) const&
+    {
+        using Result = Expected<std::invoke_result_t<F, const T&>, E>;
+
+        if (has_value())
+            return Result{std::invoke(std::forward<F>(f), this->value_)};
+
+        return Result{Unexpected{this->error_}};
+    }
+
+    template <typename F>
+    auto map(F&& f) &&
+    {
+        using Result = Expected<std::invoke_result_t<F, T&&>, E>;
+
+        if (has_value())
+            return Result{std::invoke(std::forward<F>(f), std::move(this->value_))};
+
+        return Result{Unexpected{std::move(this->error_)}};
+    }
+
+    // f(E) -> Expected<T, G>
+    template <typename F>
+    auto or_else(F&& f) const&
+    {
+        using Result = std::invoke_result_t<F, const E&>;
+
+        if (!has_value())
+            return std::invoke(std::forward<F>(f), this->error_);
+
+        return Result{this->value_};
+    }
+
+    template <typename F>
+    auto or_else(F&& f) &&
+    {
+        using Result = std::invoke_result_t<F, E&&>;
+
+        if (!has_value())
+            return std::invoke(std::forward<F>(f), std::move(this->error_));
+
+        return Result{std::move(this->value_)};
+    }
+
+private:
+    void check_value() const
+    {
+        if (!has_value())
+            throw BadExpectedAccess{};
+    }
+};
+
+#endif // EXPECTED_HPP
@@ -0,0 +1,125 @@
+#ifndef FAST_VISIT_HPP
+#define FAST_VISIT_HPP
+
+#include <cstdlib>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// std::visit replacement - a switch on index() guarantees a jump table for up to 32 alternatives
+namespace FastVisit
+{
+    constexpr size_t max_switch_alternatives = 32;
+
+    template <typename TVariant>
+    constexpr size_t variant_size_v = std::variant_size_v<std::remove_cv_t<std::remove_reference_t<TVariant>>>;
+
+    template <size_t Index, typename TVariant>
+    decltype(auto) get_unchecked(TVariant&& v)
+    {
+        // index was already checked by the switch - std::get_if does not throw
+        using Alternative = decltype(std::get<Index>(std::forward<TVariant>(v)));
+        return static_cast<Alternative>(*std::get_if<Index>(&v));
+    }
+
+    [[noreturn]] inline void unreachable()
+    {
+#if defined(__GNUC__)
+        __builtin_unreachable();
+#elif defined(_MSC_VER)
+        __assume(false);
+#else
+        std::abort();
+#endif
+    }
+
+    template <typename TVisitor, typename TVariant>
+    using visit_result_t = std::invoke_result_t<TVisitor, decltype(std::get<0>(std::declval<TVariant>()))>;
+
+    template <typename TVisitor, typename TVariant>
+    visit_result_t<TVisitor, TVariant> visit_one(TVisitor&& visitor, TVariant&& v)
+    {
+        constexpr size_t size = variant_size_v<TVariant>;
+
+        if constexpr (size > max_switch_alternatives)
+        {
+            return std::visit(std::forward<TVisitor>(visitor), std::forward<TVariant>(v));
+        }
+        else
+        {
+            // cases beyond the number of alternatives are never taken - they are marked unreachable,
+            // so the compiler may emit a plain jump table
+#define FAST_VISIT_CASE(Index)                                                                                    \
+    case Index:                                                                                                   \
+        if constexpr (Index < size)                                                                               \
+            return std::invoke(std::forward<TVisitor>(visitor), get_unchecked<Index>(std::forward<TVariant>(v))); \
+        else                                                                                                      \
+            unreachable();
+
+            switch (v.index())
+            {
+                FAST_VISIT_CASE(0)
+                FAST_VISIT_CASE(1)
+                FAST_VISIT_CASE(2)
+                FAST_VISIT_CASE(3)
+                FAST_VISIT_CASE(4)
+                FAST_VISIT_CASE(5)
+                FAST_VISIT_CASE(6)
+                FAST_VISIT_CASE(7)
+                FAST_VISIT_CASE(8)
+                FAST_VISIT_CASE(9)
+                FAST_VISIT_CASE(10)
+                FAST_VISIT_CASE(11)
+                FAST_VISIT_CASE(12)
+                FAST_VISIT_CASE(13)
+                FAST_VISIT_CASE(14)
+                FAST_VISIT_CASE(15)
+                FAST_VISIT_CASE(16)
+                FAST_VISIT_CASE(17)
+                FAST_VISIT_CASE(18)
+                FAST_VISIT_CASE(19)
+                FAST_VISIT_CASE(20)
+                FAST_VISIT_CASE(21)
+                FAST_VISIT_CASE(22)
+                FAST_VISIT_CASE(23)
+                FAST_VISIT_CASE(24)
+                FAST_VISIT_CASE(25)
+                FAST_VISIT_CASE(26)
+                FAST_VISIT_CASE(27)
+                FAST_VISIT_CASE(28)
+                FAST_VISIT_CASE(29)
+                FAST_VISIT_CASE(30)
+                FAST_VISIT_CASE(31)
+            }
+
+#undef FAST_VISIT_CASE
+
+            throw std::bad_variant_access{}; // valueless_by_exception()
+        }
+    }
+}
+
+template <typename TVisitor, typename TVariant>
+decltype(auto) fast_visit(TVisitor&& visitor, TVariant&& v)
+{
+    return FastVisit::visit_one(std::forward<TVisitor>(visitor), std::forward<TVariant>(v));
+}
+
+// multi-variant visitation - the first variant is dispatched, the rest is visited with the alternative bound
+template <typename TVisitor, typename TVariant, typename... TVariants>
+decltype(auto) fast_visit(TVisitor&& visitor, TVariant&& v, TVariants&&... vs)
+{
+    return FastVisit::visit_one(
+        [&](auto&& alternative) -> decltype(auto) {
+            return fast_visit(
+                [&](auto&&... alternatives) -> decltype(auto) {
+                    return std::invoke(std::forward<TVisitor>(visitor), std::forward<decltype(alternative)>(alternative),
+                        std::forward<decltype(alternatives)>(alternatives)...);
+                },
+                std::forward<TVariants>(vs)...);
+        },
+        std::forward<TVariant>(v));
+}
+
+#endif // FAST_VISIT_HPP
@@ -0,0 +1,229 @@
+#ifndef FILE_CONTENT_HPP
+#define FILE_CONTENT_HPP
+
+#include <cerrno>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <variant>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FILE_CONTENT_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace FileContentDetails
+{
+    inline std::errc last_error()
+    {
+        return static_cast<std::errc>(errno);
+    }
+
+#ifdef FILE_CONTENT_POSIX
+    class FileDescriptor
+    {
+        int fd_;
+
+    public:
+        explicit FileDescriptor(int fd)
+            : fd_{fd}
+        {
+        }
+
+        FileDescriptor(const FileDescriptor&) = delete;
+        FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+        ~FileDescriptor()
+        {
+            if (fd_ >= 0)
+                ::close(fd_);
+        }
+
+        int get() const
+        {
+            return fd_;
+        }
+    };
+
+    // reads the whole file with as few read() calls as possible into a pre-sized buffer
+    inline std::variant<std::string, std::errc> read_all(int fd, size_t size)
+    {
+        std::string content(size, '\0');
+
+        size_t total = 0;
+        while (total < size)
+        {
+            const ssize_t count = ::read(fd, content.data() + total, size - total);
+
+            if (count < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return last_error();
+            }
+
+            if (count == 0) // file was truncated in the meantime
+                break;
+
+            total += static_cast<size_t>(count);
+        }
+
+        content.resize(total);
+
+        return content;
+    }
+#endif
+}
+
+// content of a file - a memory mapping for large files, an owned buffer for small ones;
+// views returned by view() are valid as long as the FileContent object lives
+class FileContent
+{
+    std::string buffer_;
+    const char* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+
+    void unmap() noexcept
+    {
+#ifdef FILE_CONTENT_POSIX
+        if (mapping_)
+            ::munmap(const_cast<char*>(mapping_), mapping_size_);
+#endif
+        mapping_ = nullptr;
+        mapping_size_ = 0;
+    }
+
+public:
+    static constexpr size_t mmap_threshold = 1024 * 1024;
+
+    explicit FileContent(std::string buffer)
+        : buffer_{std::move(buffer)}
+    {
+    }
+
+    FileContent(const char* mapping, size_t size)
+        : mapping_{mapping}, mapping_size_{size}
+    {
+    }
+
+    FileContent(const FileContent&) = delete;
+    FileContent& operator=(const FileContent&) = delete;
+
+    FileContent(FileContent&& other) noexcept
+        : buffer_{std::move(other.buffer_)}
+        , mapping_{std::exchange(other.mapping_, nullptr)}
+        , mapping_size_{std::exchange(other.mapping_size_, 0)}
+    {
+    }
+
+    FileContent& operator=(FileContent&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            buffer_ = std::move(other.buffer_);
+            mapping_ = std::exchange(other.mapping_, nullptr);
+            mapping_size_ = std::exchange(other.mapping_size_, 0);
+        }
+
+        return *this;
+    }
+
+    ~FileContent()
+    {
+        unmap();
+    }
+
+    bool is_mapped() const noexcept
+    {
+        return mapping_ != nullptr;
+    }
+
+    std::string_view view() const noexcept
+    {
+        return is_mapped() ? std::string_view(mapping_, mapping_size_) : std::string_view(buffer_);
+    }
+};
+
+// no exceptions - errors are reported as std::errc
+[[nodiscard]] inline std::variant<FileContent, std::errc> open_content(const std::string& filename)
+{
+#ifdef FILE_CONTENT_POSIX
+    using namespace FileContentDetails;
+
+    FileDescriptor file{::open(filename.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (file.get() < 0)
+        return last_error();
+
+    struct stat file_stat;
+    if (::fstat(file.get(), &file_stat) != 0)
+        return last_error();
+
+    if (!S_ISREG(file_stat.st_mode))
+        return std::errc::invalid_argument;
+
+    const size_t size = static_cast<size_t>(file_stat.st_size);
+
+    if (size >= FileContent::mmap_threshold)
+    {
+        void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.get(), 0);
+        if (mapping == MAP_FAILED)
+            return last_error();
+
+        ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+        return FileContent{static_cast<const char*>(mapping), size};
+    }
+
+    auto content = read_all(file.get(), size);
+    if (auto* error = std::get_if<std::errc>(&content))
+        return *error;
+
+    return FileContent{std::get<std::string>(std::move(content))};
+#else
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file)
+        return std::errc::no_such_file_or_directory;
+
+    std::string content(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    if (!file.read(content.data(), content.size()))
+        return std::errc::io_error;
+
+    return FileContent{std::move(content)};
+#endif
+}
+
+// whole content copied into a string - a single read() into a pre-sized buffer
+[[nodiscard]] inline std::variant<std::string, std::errc> read_content(const std::string& filename)
+{
+#ifdef FILE_CONTENT_POSIX
+    using namespace FileContentDetails;
+
+    FileDescriptor file{::open(filename.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (file.get() < 0)
+        return last_error();
+
+    struct stat file_stat;
+    if (::fstat(file.get(), &file_stat) != 0)
+        return last_error();
+
+    if (!S_ISREG(file_stat.st_mode))
+        return std::errc::invalid_argument;
+
+    return read_all(file.get(), static_cast<size_t>(file_stat.st_size));
+#else
+    auto content = open_content(filename);
+    if (auto* error = std::get_if<std::errc>(&content))
+        return *error;
+
+    return std::string(std::get<FileContent>(content).view());
+#endif
+}
+
+#endif // FILE_CONTENT_HPP
@@ -0,0 +1,78 @@
+#ifndef POLY_COLLECTION_HPP
+#define POLY_COLLECTION_HPP
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// each alternative is stored in its own vector - for_each visits type by type,
+// so the visitor call is monomorphic (and inlinable) in every loop
+// (insertion order is preserved only between items of the same type)
+template <typename... Ts>
+class PolyCollection
+{
+    std::tuple<std::vector<Ts>...> segments_;
+
+public:
+    template <typename T>
+    void insert(T&& item)
+    {
+        segment<std::decay_t<T>>().push_back(std::forward<T>(item));
+    }
+
+    template <typename T, typename... TArgs>
+    T& emplace(TArgs&&... args)
+    {
+        return segment<T>().emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    template <typename T>
+    std::vector<T>& segment()
+    {
+        return std::get<std::vector<T>>(segments_);
+    }
+
+    template <typename T>
+    const std::vector<T>& segment() const
+    {
+        return std::get<std::vector<T>>(segments_);
+    }
+
+    size_t size() const
+    {
+        return (... + segment<Ts>().size());
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    void clear()
+    {
+        (..., segment<Ts>().clear());
+    }
+
+    template <typename TVisitor>
+    void for_each(TVisitor&& visitor)
+    {
+        (..., for_each_in(segment<Ts>(), visitor));
+    }
+
+    template <typename TVisitor>
+    void for_each(TVisitor&& visitor) const
+    {
+        (..., for_each_in(segment<Ts>(), visitor));
+    }
+
+private:
+    template <typename TSegment, typename TVisitor>
+    static void for_each_in(TSegment& items, TVisitor& visitor)
+    {
+        for (auto& item : items)
+            visitor(item);
+    }
+};
+
+#endif // POLY_COLLECTION_HPP
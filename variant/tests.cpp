@@ -1,11 +1,23 @@
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <numeric>
 #include <iostream>
+#include <random>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+#include <utility>
 #include <vector>
 #include <variant>
 
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include "catch.hpp"
+#include "compact_variant.hpp"
+#include "expected.hpp"
+#include "file_content.hpp"
+#include "fast_visit.hpp"
+#include "poly_collection.hpp"
 
 using namespace std;
 
@@ -96,19 +108,694 @@ TEST_CASE("visiting")
 }
 
 
+TEST_CASE("fast_visit")
+{
+    std::variant<int, double, std::string, std::vector<int>> v = "text"s;
+
+    fast_visit(Printer{}, v);
+
+    auto describe = overload {
+        [](int) { return "int"s; },
+        [](double) { return "double"s; },
+        [](const std::string& s) { return "string: "s + s; },
+        [](const std::vector<int>& v) { return "vector: "s + std::to_string(v.size()); }
+    };
+
+    REQUIRE(fast_visit(describe, v) == "string: text");
+
+    v = std::vector{1, 2, 3};
+    REQUIRE(fast_visit(describe, v) == "vector: 3");
+
+    SECTION("modifying alternative")
+    {
+        fast_visit([](auto& value) { value = {}; }, v);
+        REQUIRE(std::get<std::vector<int>>(v).empty());
+    }
+
+    SECTION("rvalue variant")
+    {
+        auto moved_size = fast_visit([](auto&& value) {
+            auto target = std::move(value);
+            return sizeof(target);
+        }, std::move(v));
+
+        REQUIRE(moved_size == sizeof(std::vector<int>));
+        REQUIRE(std::get<std::vector<int>>(v).empty());
+    }
+
+    SECTION("multi-variant visitation")
+    {
+        std::variant<int, double> a = 2;
+        std::variant<int, double, std::string> b = 1.5;
+
+        auto add = overload {
+            [](const auto& x, const auto& y) -> std::string { return std::to_string(x + y); },
+            [](const auto& x, const std::string& s) -> std::string { return std::to_string(x) + s; }
+        };
+
+        REQUIRE(fast_visit(add, a, b) == std::visit(add, a, b));
+
+        b = "!"s;
+        REQUIRE(fast_visit(add, a, b) == "2!");
+    }
+}
+
+template <int Id>
+struct Alternative
+{
+    int value;
+};
+
+template <typename TVariant, size_t... Is>
+std::vector<TVariant> random_variants(size_t count, std::index_sequence<Is...>)
+{
+    using Factory = TVariant (*)(int);
+    static constexpr Factory factories[] = { [](int value) -> TVariant { return Alternative<Is>{value}; }... };
+
+    std::mt19937 rnd{665};
+    std::uniform_int_distribution<size_t> distr(0, sizeof...(Is) - 1);
+
+    std::vector<TVariant> variants;
+    for (size_t i = 0; i < count; ++i)
+        variants.push_back(factories[distr(rnd)](static_cast<int>(i)));
+
+    return variants;
+}
+
+template <size_t... Is>
+void benchmark_visit(std::index_sequence<Is...> alternatives)
+{
+    using Variant = std::variant<Alternative<Is>...>;
+
+    const auto variants = random_variants<Variant>(1'000'000, alternatives);
+    auto visitor = [](const auto& alternative) { return alternative.value; };
+
+    BENCHMARK("std::visit - " + std::to_string(sizeof...(Is)) + " alternatives")
+    {
+        long long sum = 0;
+        for (const auto& v : variants)
+            sum += std::visit(visitor, v);
+        return sum;
+    };
+
+    BENCHMARK("fast_visit - " + std::to_string(sizeof...(Is)) + " alternatives")
+    {
+        long long sum = 0;
+        for (const auto& v : variants)
+            sum += fast_visit(visitor, v);
+        return sum;
+    };
+}
+
+TEST_CASE("fast_visit - benchmark", "[.][benchmark]")
+{
+    benchmark_visit(std::make_index_sequence<2>{});
+    benchmark_visit(std::make_index_sequence<8>{});
+    benchmark_visit(std::make_index_sequence<32>{});
+}
+
+TEST_CASE("CompactVariant")
+{
+    SECTION("packed payload")
+    {
+        using Value = CompactVariant<int, double, char>;
+
+        static_assert(sizeof(Value) == sizeof(double) + 1);
+        static_assert(sizeof(std::variant<int, double, char>) == 2 * sizeof(double));
+        static_assert(std::is_same_v<Value::index_type, uint8_t>);
+
+        Value v;
+        REQUIRE(v.holds_alternative<int>());
+        REQUIRE(v.get<int>() == 0);
+
+        v = 3.14;
+        REQUIRE(v.index() == 1);
+        REQUIRE(v.get<double>() == Approx(3.14));
+        REQUIRE_THROWS_AS(v.get<int>(), std::bad_variant_access);
+
+        auto describe = overload {
+            [](int) { return "int"s; },
+            [](double) { return "double"s; },
+            [](char) { return "char"s; }
+        };
+
+        REQUIRE(v.visit(describe) == "double");
+    }
+
+    SECTION("index stored in alignment bits of pointers")
+    {
+        int x = 42;
+        double pi = 3.14;
+
+        using Ptr = CompactVariant<int*, double*>;
+
+        static_assert(Ptr::uses_pointer_tag);
+        static_assert(sizeof(Ptr) == sizeof(void*));
+        static_assert(!CompactVariant<char*, int*>::uses_pointer_tag); // char has no spare bits
+
+        Ptr ptr = &pi;
+        REQUIRE(ptr.index() == 1);
+        REQUIRE(*ptr.get<double*>() == 3.14);
+
+        ptr = &x;
+        REQUIRE(ptr.holds_alternative<int*>());
+        REQUIRE(ptr.visit([](auto* p) { return static_cast<double>(*p); }) == 42.0);
+    }
+}
+
+TEST_CASE("VariantVector")
+{
+    VariantVector<int, double, char> vec;
+
+    vec.push_back(1);
+    vec.push_back(2.5);
+    vec.push_back('c');
+    vec.push_back(4);
+
+    REQUIRE(vec.size() == 4);
+    REQUIRE(vec.index(1) == 1);
+    REQUIRE(vec.count<int>() == 2);
+    REQUIRE(*vec.get_if<double>(1) == 2.5);
+    REQUIRE(vec.get_if<int>(1) == nullptr);
+
+    int sum = 0;
+    vec.for_each_of_type<int>([&sum](int x) { sum += x; });
+    REQUIRE(sum == 5);
+
+    REQUIRE(vec.visit(2, [](auto value) { return static_cast<int>(value); }) == 'c');
+    REQUIRE(vec.positions_of<int>() == std::vector<size_t>{0, 3});
+
+    SECTION("non-trivial alternatives")
+    {
+        VariantVector<int, double, std::string, std::vector<int>> items;
+
+        items.push_back(1);
+        items.push_back("text"s);
+        items.push_back(std::vector{1, 2, 3});
+        items.push_back(2.5);
+        items.emplace_back<std::string>(3, 'x');
+
+        std::string long_text(100, 'a'); // heap allocated - checked by sanitizers
+        items.push_back(long_text);
+
+        REQUIRE(items.size() == 6);
+        REQUIRE(items.index(2) == 3);
+        REQUIRE(items.count<std::string>() == 3);
+        REQUIRE(*items.get_if<std::string>(1) == "text");
+        REQUIRE(*items.get_if<std::string>(4) == "xxx");
+        REQUIRE(*items.get_if<std::vector<int>>(2) == std::vector{1, 2, 3});
+        REQUIRE(items.get_if<int>(1) == nullptr);
+        REQUIRE(items.positions_of<std::string>() == std::vector<size_t>{1, 4, 5});
+
+        auto describe = overload {
+            [](int x) { return std::to_string(x); },
+            [](double) { return "double"s; },
+            [](const std::string& s) { return s; },
+            [](const std::vector<int>& v) { return "vector of " + std::to_string(v.size()); }
+        };
+
+        REQUIRE(items.visit(2, describe) == "vector of 3");
+        REQUIRE(items.visit(5, describe) == long_text);
+
+        std::string joined;
+        items.for_each_of_type<std::string>([&joined](const std::string& s) { joined += s.substr(0, 4) + ";"; });
+        REQUIRE(joined == "text;xxx;aaaa;");
+
+        auto copy = items;
+        REQUIRE(copy.visit(1, describe) == "text");
+    }
+}
+
+TEST_CASE("VariantVector - benchmark", "[.][benchmark]")
+{
+    constexpr size_t size = 10'000'000;
+
+    std::vector<std::variant<int, double, char>> variants;
+    VariantVector<int, double, char> soa;
+    variants.reserve(size);
+    soa.reserve(size);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            variants.push_back(static_cast<int>(i));
+            soa.push_back(static_cast<int>(i));
+        }
+        else
+        {
+            variants.push_back(static_cast<double>(i));
+            soa.push_back(static_cast<double>(i));
+        }
+    }
+
+    BENCHMARK("vector<variant> - count ints")
+    {
+        return std::count_if(variants.begin(), variants.end(), [](const auto& v) { return std::holds_alternative<int>(v); });
+    };
+
+    BENCHMARK("VariantVector - count ints")
+    {
+        return soa.count<int>();
+    };
+
+    BENCHMARK("vector<variant> - sum of ints")
+    {
+        long long sum = 0;
+        for (const auto& v : variants)
+            if (const int* x = std::get_if<int>(&v))
+                sum += *x;
+        return sum;
+    };
+
+    BENCHMARK("VariantVector - sum of ints")
+    {
+        long long sum = 0;
+        soa.for_each_of_type<int>([&sum](int x) { sum += x; });
+        return sum;
+    };
+}
+
+TEST_CASE("PolyCollection")
+{
+    PolyCollection<int, double, std::string, std::vector<int>> items;
+
+    items.insert(1);
+    items.insert("text"s);
+    items.insert(3.14);
+    items.insert(2);
+    items.emplace<std::vector<int>>(3, 0);
+
+    REQUIRE(items.size() == 5);
+    REQUIRE(items.segment<int>() == std::vector{1, 2});
+
+    items.for_each(Printer{});
+
+    std::vector<std::string> visited;
+    items.for_each(overload {
+        [&](int x) { visited.push_back(std::to_string(x)); },
+        [&](double) { visited.push_back("double"); },
+        [&](const std::string& s) { visited.push_back(s); },
+        [&](const std::vector<int>& v) { visited.push_back("vector: " + std::to_string(v.size())); }
+    });
+
+    REQUIRE(visited == std::vector<std::string>{"1", "2", "double", "text", "vector: 3"}); // type by type
+
+    items.clear();
+    REQUIRE(items.empty());
+}
+
+namespace Shapes
+{
+    struct Circle
+    {
+        double r;
+    };
+
+    struct Square
+    {
+        double a;
+    };
+
+    struct Rectangle
+    {
+        double w, h;
+    };
+
+    struct Area
+    {
+        double operator()(const Circle& c) const { return 3.14159 * c.r * c.r; }
+        double operator()(const Square& s) const { return s.a * s.a; }
+        double operator()(const Rectangle& r) const { return r.w * r.h; }
+    };
+}
+
+TEST_CASE("PolyCollection - benchmark", "[.][benchmark]")
+{
+    using namespace Shapes;
+
+    std::vector<std::variant<Circle, Square, Rectangle>> shapes;
+    PolyCollection<Circle, Square, Rectangle> poly_shapes;
+
+    std::mt19937 rnd{665};
+    std::uniform_int_distribution<int> distr(0, 2);
+
+    for (int i = 0; i < 1'000'000; ++i)
+    {
+        const double size = i % 100;
+
+        switch (distr(rnd))
+        {
+            case 0:
+                shapes.push_back(Circle{size});
+                poly_shapes.insert(Circle{size});
+                break;
+            case 1:
+                shapes.push_back(Square{size});
+                poly_shapes.insert(Square{size});
+                break;
+            default:
+                shapes.push_back(Rectangle{size, 2.0});
+                poly_shapes.insert(Rectangle{size, 2.0});
+        }
+    }
+
+    BENCHMARK("vector<variant> + std::visit")
+    {
+        double total = 0.0;
+        for (const auto& shape : shapes)
+            total += std::visit(Area{}, shape);
+        return total;
+    };
+
+    BENCHMARK("PolyCollection::for_each")
+    {
+        double total = 0.0;
+        poly_shapes.for_each([&total](const auto& shape) { total += Area{}(shape); });
+        return total;
+    };
+}
+
+// an empty name keeps reporting bad_file_descriptor (as before loading from files)
 [[nodiscard]] std::variant<std::string, std::errc> load_content(const std::string& filename)
 {
-    if (filename == "")
+    if (filename.empty())
         return std::errc::bad_file_descriptor;
-    return "content"s;          
+    return read_content(filename);
 }
 
+// file with a unique name in the temp directory - removed when the object goes out of scope
+class TempFile
+{
+    std::string path_;
+
+    static std::string unique_path(const std::string& name)
+    {
+        static std::mt19937_64 rnd{std::random_device{}()};
+        return (std::filesystem::temp_directory_path() / (std::to_string(rnd()) + "-" + name)).string();
+    }
+
+public:
+    TempFile(const std::string& name, const std::string& content)
+        : path_{unique_path(name)}
+    {
+        std::ofstream out(path_, std::ios::binary);
+        out << content;
+    }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    ~TempFile()
+    {
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+    }
+
+    const std::string& path() const
+    {
+        return path_;
+    }
+};
+
 TEST_CASE("using variant")
 {
-    auto result = load_content("data");
+    TempFile file{"data", "content"};
+    auto result = load_content(file.path());
 
     std::visit(overload{ 
         [](std::errc ec) { std::cout << "Error!!! " <<  static_cast<int>(ec) << std::endl; },
         [](const std::string& s) { std::cout << "Content: " << s << "\n"; }
     }, result);
-}
\ No newline at end of file
+}
+
+TEST_CASE("load_content")
+{
+    SECTION("small file")
+    {
+        TempFile file{"small.txt", "small content"};
+
+        auto result = load_content(file.path());
+        REQUIRE(std::get<std::string>(result) == "small content");
+
+        auto content = open_content(file.path());
+        REQUIRE_FALSE(std::get<FileContent>(content).is_mapped());
+        REQUIRE(std::get<FileContent>(content).view() == "small content");
+    }
+
+    SECTION("large file is memory mapped")
+    {
+        const std::string text(FileContent::mmap_threshold + 1, 'x');
+        TempFile file{"large.txt", text};
+
+        auto content = open_content(file.path());
+
+        FileContent mapped = std::move(std::get<FileContent>(content));
+        REQUIRE(mapped.is_mapped());
+        REQUIRE(mapped.view() == text);
+
+        REQUIRE(std::get<std::string>(load_content(file.path())) == text);
+    }
+
+    SECTION("errors")
+    {
+        REQUIRE(std::get<std::errc>(load_content("not-existing-file.txt")) == std::errc::no_such_file_or_directory);
+        REQUIRE(std::get<std::errc>(load_content("")) == std::errc::bad_file_descriptor);
+        REQUIRE(std::get<std::errc>(read_content("")) == std::errc::no_such_file_or_directory);
+        REQUIRE(std::holds_alternative<std::errc>(open_content(std::filesystem::temp_directory_path().string())));
+    }
+
+    SECTION("temporary files are removed")
+    {
+        std::string path;
+        {
+            TempFile file{"small.txt", "text"};
+            path = file.path();
+            REQUIRE(std::filesystem::exists(path));
+        }
+        REQUIRE_FALSE(std::filesystem::exists(path));
+    }
+}
+
+std::string load_content_with_ifstream(const std::string& filename)
+{
+    std::ifstream in(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+TEST_CASE("load_content - benchmark", "[.][benchmark]")
+{
+    for (size_t size : {1024ul, 1024ul * 1024, 256ul * 1024 * 1024})
+    {
+        const TempFile file{"benchmark.txt", std::string(size, 'x')};
+        const auto& path = file.path();
+        const auto suffix = " - " + std::to_string(size / 1024) + " KB";
+
+        BENCHMARK("ifstream" + suffix)
+        {
+            return load_content_with_ifstream(path).size();
+        };
+
+        BENCHMARK("load_content" + suffix)
+        {
+            return std::get<std::string>(load_content(path)).size();
+        };
+
+        BENCHMARK("open_content (view)" + suffix)
+        {
+            auto content = open_content(path);
+            const auto view = std::get<FileContent>(content).view();
+            return std::count(view.begin(), view.end(), 'x');
+        };
+    }
+}
+
+[[nodiscard]] Expected<std::string, std::errc> try_load_content(const std::string& filename)
+{
+    if (filename == "")
+        return Unexpected{std::errc::bad_file_descriptor};
+    return "content"s;
+}
+
+namespace
+{
+    // copy and move may throw - the worst case for changing the state of Expected
+    struct Fragile
+    {
+        inline static bool fail = false;
+        std::string text;
+
+        explicit Fragile(std::string text)
+            : text{std::move(text)}
+        {
+        }
+
+        Fragile(const Fragile& other)
+            : text{other.text}
+        {
+            if (fail)
+                throw std::runtime_error{"copy failed"};
+        }
+
+        Fragile(Fragile&& other)
+            : Fragile(static_cast<const Fragile&>(other))
+        {
+        }
+
+        Fragile& operator=(const Fragile&) = default;
+        Fragile& operator=(Fragile&&) = default;
+    };
+}
+
+TEST_CASE("Expected - assignment")
+{
+    using Result = Expected<Fragile, std::string>;
+
+    Result value{Fragile{"value"}};
+    Result error{Unexpected{"error"s}};
+
+    SECTION("same state - members are assigned")
+    {
+        Result other{Fragile{"other"}};
+        value = other;
+        REQUIRE(value->text == "other");
+
+        error = Result{Unexpected{"other error"s}};
+        REQUIRE(error.error() == "other error");
+    }
+
+    SECTION("state changes")
+    {
+        Result target = value;
+        target = error;
+        REQUIRE(target.error() == "error");
+
+        target = value;
+        REQUIRE(target->text == "value");
+    }
+
+    SECTION("throwing copy leaves the previous error")
+    {
+        Fragile::fail = true;
+        REQUIRE_THROWS_AS(error = value, std::runtime_error);
+        Fragile::fail = false;
+
+        REQUIRE_FALSE(error.has_value());
+        REQUIRE(error.error() == "error");
+    }
+}
+
+TEST_CASE("using Expected")
+{
+    static_assert(std::is_trivially_copyable_v<Expected<int, std::errc>>);
+    static_assert(!std::is_trivially_copyable_v<Expected<std::string, std::errc>>);
+
+    auto result = try_load_content("data");
+
+    if (result)
+        std::cout << "Content: " << *result << "\n";
+    else
+        std::cout << "Error!!! " << static_cast<int>(result.error()) << std::endl;
+
+    REQUIRE(result.value() == "content");
+
+    SECTION("error")
+    {
+        auto error = try_load_content("");
+
+        REQUIRE_FALSE(error.has_value());
+        REQUIRE(error.error() == std::errc::bad_file_descriptor);
+        REQUIRE(error.value_or("default") == "default");
+        REQUIRE_THROWS_AS(error.value(), BadExpectedAccess);
+    }
+
+    SECTION("monadic operations")
+    {
+        auto to_length = [](const std::string& content) { return content.size(); };
+        auto check_not_empty = [](size_t length) -> Expected<size_t, std::errc> {
+            if (length == 0)
+                return Unexpected{std::errc::no_message_available};
+            return length;
+        };
+
+        auto length = try_load_content("data").map(to_length).and_then(check_not_empty);
+        REQUIRE(*length == 7);
+
+        auto failed = try_load_content("").map(to_length).and_then(check_not_empty);
+        REQUIRE(failed.error() == std::errc::bad_file_descriptor);
+
+        auto recovered = try_load_content("").or_else([](std::errc) -> Expected<std::string, std::errc> { return "backup"s; });
+        REQUIRE(*recovered == "backup");
+    }
+}
+
+namespace ErrorHandling
+{
+    // every 10th value is an error
+    std::variant<int, std::errc> parse_variant(int x)
+    {
+        if (x % 10 == 0)
+            return std::errc::invalid_argument;
+        return x;
+    }
+
+    Expected<int, std::errc> parse_expected(int x)
+    {
+        if (x % 10 == 0)
+            return Unexpected{std::errc::invalid_argument};
+        return x;
+    }
+
+    int parse_exception(int x)
+    {
+        if (x % 10 == 0)
+            throw std::invalid_argument("invalid argument");
+        return x;
+    }
+}
+
+TEST_CASE("Expected - benchmark", "[.][benchmark]")
+{
+    using namespace ErrorHandling;
+
+    constexpr int count = 100'000;
+
+    BENCHMARK("variant + visit")
+    {
+        long long sum = 0;
+        for (int i = 0; i < count; ++i)
+            std::visit(overload {
+                [&sum](int x) { sum += x; },
+                [&sum](std::errc) { --sum; }
+            }, parse_variant(i));
+        return sum;
+    };
+
+    BENCHMARK("Expected")
+    {
+        long long sum = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            auto result = parse_expected(i);
+            sum += result ? *result : -1;
+        }
+        return sum;
+    };
+
+    BENCHMARK("exceptions")
+    {
+        long long sum = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            try
+            {
+                sum += parse_exception(i);
+            }
+            catch (const std::invalid_argument&)
+            {
+                --sum;
+            }
+        }
+        return sum;
+    };
+}